@@ -1,10 +1,24 @@
 #include "DatabaseInterface.h"
 
 #include <ctime>
+#include <cctype>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <map>
+#include <algorithm>
+
+#include "WorkQueue.h"
+#include "G6FileTable.h"
 
 
 #define PI 3.14159265
 #define max_column_width 66
+#define GRAPH_COLUMN "COALESCE(g6,edges)"
+#define SCRIPT_PROGRESS "(SELECT COUNT(*) FROM Batches WHERE Batches.scriptID == Scripts.scriptID AND status == 'done') AS done,(SELECT SUM(runtime) FROM Batches WHERE Batches.scriptID == Scripts.scriptID) AS runtime"
 
 //########## helper functions ##########
 /**
@@ -39,6 +53,20 @@ inline std::string cdatetime() {
 }
 
 
+/**
+ * returns the name of the boolean column of given type, i.e., the type without non-alphanumeric characters (e.g., 'clawfree' for 'claw-free')
+**/
+inline std::string type_column(const char * type) {
+	std::string column = "";
+	for (const char * c = type; *c; c++)
+	{
+		if (isalnum((unsigned char)*c))
+			column.push_back(*c);
+	}
+	return column;
+}
+
+
 /**
  * returns the appropriate coordinates for a vertex to print the graph of given order on a circle
 **/
@@ -50,16 +78,676 @@ std::pair<int, int> get_coordinate(unsigned vertex, unsigned order) {
 }
 
 
+/**
+ * returns the graph stored in given column of the current row of qry, i.e., a g6 BLOB or (for graphs imported without one) a list of edges of a graph of given order
+ * changes g6 to whether the graph was stored as a g6 BLOB
+**/
+inline std::string read_graph_column(sqlite3_stmt * qry, int column, bool * g6) {
+	*g6 = sqlite3_column_type(qry, column) == SQLITE_BLOB;
+
+	const char * data = (const char *)sqlite3_column_blob(qry, column);
+	return data ? std::string(data, sqlite3_column_bytes(qry, column)) : std::string();
+}
+
+
+/**
+ * changes g to the graph given by edges, which are either Graph6 bytes (if g6 is set) or a list of edges of a graph of given order
+ * returns false if edges could not be decoded
+**/
+inline bool read_graph(Graph * g, unsigned order, std::string * edges, bool g6) {
+	if (g6)
+		return g->read_graph_from_g6(edges);
+	else
+		return g->read_graph_from_line(order, edges);
+}
+
+
+/**
+* graphs of the rows of a chunk of the compute and classify pipeline, each decoded once on first use
+* the graphs of small orders are also loaded once into batches of up to BATCH_SIZE graphs of the same order (if there are at least BATCH_MIN_GRAPHS of them), together with the indices of their rows
+* graphs that cannot be decoded are left out of the batches and must not be evaluated, which is tested by is_valid
+**/
+struct Chunk_graphs
+{
+	std::vector<Graph_row> * rows;
+	std::vector<Graph> graphs;
+	std::vector<bool> decoded;
+	std::vector<bool> valid;	// set once a graph is decoded or added to a batch from its Graph6 successfully
+	std::vector<GraphBatch> batches;
+	std::vector<std::vector<unsigned>> batch_rows;
+	bool batched;
+
+	Chunk_graphs(std::vector<Graph_row> * rows) : rows(rows), graphs(rows->size()), decoded(rows->size(), false), valid(rows->size(), false), batched(false) {}
+
+	Graph * get(unsigned i) {
+		if (!decoded[i])
+		{
+			valid[i] = read_graph(&graphs[i], rows->at(i).order, &rows->at(i).edges, rows->at(i).g6);
+			decoded[i] = true;
+		}
+		return &graphs[i];
+	}
+
+	bool is_valid(unsigned i) {
+		if (!valid[i])
+			get(i);
+		return valid[i];
+	}
+
+	void load_batches() {
+		batched = true;
+		std::vector<std::vector<unsigned>> orders(BATCH_MAX_ORDER + 1);
+
+		for (unsigned i = 0; i < rows->size(); i++)
+		{
+			if (rows->at(i).order <= BATCH_MAX_ORDER)
+				orders[rows->at(i).order].push_back(i);
+		}
+
+		for (unsigned order = 0; order <= BATCH_MAX_ORDER; order++)
+		{
+			if (orders[order].size() < BATCH_MIN_GRAPHS)
+				continue;
+
+			for (unsigned start = 0; start < orders[order].size(); start += BATCH_SIZE)
+			{
+				batches.push_back(GraphBatch(order));
+				batch_rows.push_back({});
+
+				for (unsigned k = start; k < orders[order].size() && k < start + BATCH_SIZE; k++)
+				{
+					unsigned i = orders[order][k];
+					Graph_row * row = &rows->at(i);
+
+					if (row->g6 && batches.back().add_graph_from_g6(row->edges.data(), row->edges.length()))
+						valid[i] = true;
+					else if (!is_valid(i)
+						|| !batches.back().add_graph(get(i)))
+						continue;
+
+					batch_rows.back().push_back(i);
+				}
+			}
+		}
+	}
+};
+
+
+/**
+ * calls visit for all batches of chunk together with the indices of their rows, the rows with given flag set among them get their entry in batched set
+**/
+inline void visit_batches(Chunk_graphs * chunk, unsigned flag, std::vector<bool> * batched, std::function<void(GraphBatch * batch, std::vector<unsigned> * indices)> visit) {
+	if (!chunk->batched)
+		chunk->load_batches();
+
+	for (unsigned b = 0; b < chunk->batches.size(); b++)
+	{
+		std::vector<unsigned> * indices = &chunk->batch_rows[b];
+		visit(&chunk->batches[b], indices);
+
+		for (unsigned k = 0; k < indices->size(); k++)
+		{
+			if ((chunk->rows->at(indices->at(k)).flags >> flag) & 1)
+				batched->at(indices->at(k)) = true;
+		}
+	}
+}
+
+
+/**
+ * SQL graph function evaluating the test or value of its Graph_function on the graph given either as graph (Graph6 BLOB) or as graphOrder, graph (Graph6 BLOB or list of edges)
+ * the graph is only decoded if it differs from the one of the last call of any graph function
+ * returns NULL for a NULL graph and for values without one, raises an SQL error for graphs that cannot be decoded
+**/
+void evaluate_graph_function(sqlite3_context * context, int argc, sqlite3_value ** argv) {
+	Graph_function * function = (Graph_function *)sqlite3_user_data(context);
+	Function_cache * cache = function->cache.get();
+	sqlite3_value * graph = argv[argc - 1];
+
+	if (sqlite3_value_type(graph) == SQLITE_NULL
+		|| sqlite3_value_type(argv[0]) == SQLITE_NULL)
+	{
+		sqlite3_result_null(context);
+		return;
+	}
+
+	bool g6 = argc == 1 || sqlite3_value_type(graph) == SQLITE_BLOB;
+	int order = argc == 1 ? 0 : sqlite3_value_int(argv[0]);
+	const char * data = (const char *)sqlite3_value_blob(graph);
+	int bytes = sqlite3_value_bytes(graph);
+
+	if (!data
+		|| (argc == 1 && sqlite3_value_type(graph) != SQLITE_BLOB)
+		|| (!g6 && (order < 0 || order > 62 || bytes < 2)))
+	{
+		sqlite3_result_error(context, "invalid graph", -1);
+		return;
+	}
+
+	std::string key = std::to_string(order) + (g6 ? ":" : ";") + std::string(data, bytes);
+
+	if (key != cache->key)
+	{
+		std::string edges(data, bytes);
+		cache->computed.assign(cache->computed.size(), false);
+
+		if (!read_graph(&cache->graph, order, &edges, g6)
+			|| (argc == 2 && g6 && cache->graph.get_order() != (unsigned)order))
+		{
+			// the cached graph may be partially overwritten, so it must not be reused for the previous key either
+			cache->key = "";
+			sqlite3_result_error(context, "invalid graph", -1);
+			return;
+		}
+
+		cache->key = key;
+	}
+
+	if (function->test)
+	{
+		sqlite3_result_int(context, (cache->graph.*function->test)() ? 1 : 0);
+		return;
+	}
+
+	if (!cache->computed[function->getter_number])
+	{
+		cache->values[function->getter_number] = (cache->graph.*function->getter)();
+		cache->computed[function->getter_number] = true;
+	}
+
+	std::vector<unsigned> * values = &cache->values[function->getter_number];
+	if (function->value_index >= values->size()
+		|| values->at(function->value_index) == NULL_VALUE)
+		sqlite3_result_null(context);
+	else
+		sqlite3_result_int64(context, values->at(function->value_index));
+}
+
+
+/**
+ * frees the Graph_function of an SQL graph function once SQLite drops it
+**/
+void delete_graph_function(void * function) {
+	delete (Graph_function *)function;
+}
+
+
+/**
+ * skips empty lines and reads the line '#[graphID]' which generated scripts write in front of every result
+ * returns false without consuming anything else if the next result has no such line (i.e., stems from a script without graphIDs)
+**/
+inline bool read_result_graphID(std::ifstream * file, int * graphID) {
+	while (file->peek() == '\n'
+		|| file->peek() == '\r')
+		file->get();
+
+	if (file->peek() != '#')
+		return false;
+
+	std::string line;
+	getline(*file, line);
+
+	*graphID = 0;
+	for (unsigned i = 1; i < line.length() && line.at(i) >= '0' && line.at(i) <= '9'; i++)
+	{
+		*graphID *= 10;
+		*graphID += line.at(i) - '0';
+	}
+	return true;
+}
+
+
+//########## private member functions ##########
+/**
+ * returns the condition restricting a resumed job to the graphs after the lastGraphID of the job with given jobID (empty if jobID is -1, unknown or has not committed any graphs yet)
+**/
+std::string DatabaseInterface::resume_condition(int jobID) {
+	std::string command;
+	int last_graphID;
+
+	if (jobID == -1
+		|| !find_job(jobID, &command, &last_graphID)
+		|| last_graphID == 0)
+		return "";
+
+	return " AND graphID > " + std::to_string(last_graphID);
+}
+
+
+/**
+ * returns the default estimate of the cost of computing the results of a graph in Macaulay2
+ * the number of variables and generators of its ideals grow with graphOrder and graphSize, a computed number of maximal cliques (if any) accounts for the structure of the graph
+**/
+std::string DatabaseInterface::get_default_cost_model() {
+	std::string model = DEFAULT_COST_MODEL;
+
+	sqlite3_stmt * qry;
+	if (sqlite3_prepare_v2(database, "SELECT maxCliques FROM Graphs", -1, &qry, 0) == SQLITE_OK)
+		model += " * COALESCE(maxCliques, 1)";
+	sqlite3_finalize(qry);
+
+	return model;
+}
+
+
+/**
+ * returns the current value of given pragma as text (or an empty string if it has none)
+**/
+std::string DatabaseInterface::get_pragma(const char * pragma) {
+	sqlite3_stmt * qry;
+	std::string value = "";
+
+	if (sqlite3_prepare_v2(database, ("PRAGMA " + std::string(pragma) + ";").c_str(), -1, &qry, 0) == SQLITE_OK
+		&& sqlite3_step(qry) == SQLITE_ROW
+		&& sqlite3_column_text(qry, 0))
+		value = (char *)sqlite3_column_text(qry, 0);
+
+	sqlite3_finalize(qry);
+	return value;
+}
+
+
+/**
+ * returns the current row of stmt as strings ('-' for NULL)
+**/
+std::vector<std::string> DatabaseInterface::read_view_row(sqlite3_stmt * stmt) {
+	std::vector<std::string> row;
+	row.reserve(number_columns);
+
+	for (unsigned j = 0; j < number_columns; j++)
+		row.push_back((char *)sqlite3_column_text(stmt, j) ? (char *)sqlite3_column_text(stmt, j) : "-");
+
+	return row;
+}
+
+
+/**
+ * calls visit on every row of the current view in order until it returns false
+ * rows beyond the cached ones are streamed by executing the query of the view again, which is refused if the database has changed since the view was created
+ * returns false if the query could not be executed again
+**/
+bool DatabaseInterface::step_view(std::function<bool(unsigned index, std::vector<std::string> * row)> visit) {
+	for (unsigned i = 0; i < view_cache.size(); i++)
+	{
+		if (!visit(i, &view_cache[i]))
+			return true;
+	}
+
+	if (view_complete)
+		return true;
+
+	if (!check_view())
+		return false;
+
+	sqlite3_stmt * stmt;
+
+	if (sqlite3_prepare_v2(database, view_query.c_str(), -1, &stmt, 0) != SQLITE_OK)
+	{
+		SQL_ERROR(view_query);
+		FAIL("Reading view", "");
+		sqlite3_finalize(stmt);
+		return false;
+	}
+
+	unsigned i = 0;
+	int step;
+	while ((step = sqlite3_step(stmt)) == SQLITE_ROW)
+	{
+		if (i >= view_cache.size())
+		{
+			std::vector<std::string> row = read_view_row(stmt);
+			if (!visit(i, &row))
+				break;
+		}
+		i++;
+	}
+
+	if (step != SQLITE_ROW
+		&& step != SQLITE_DONE)
+	{
+		FAIL("Reading view", sqlite3_errmsg(database) << ".");
+		sqlite3_finalize(stmt);
+		return false;
+	}
+
+	sqlite3_finalize(stmt);
+	return true;
+}
+
+
+/**
+ * returns the widths of the columns of the current view wide enough for all of its rows (or only the first limit rows)
+**/
+std::vector<unsigned> DatabaseInterface::get_column_widths(int limit) {
+	std::vector<unsigned> column_widths;
+
+	for (unsigned j = 0; j < number_columns; j++)
+		column_widths.push_back(view_columns[j].length() + 3);
+
+	step_view([this, limit, &column_widths](unsigned i, std::vector<std::string> * row) {
+		if (limit != -1
+			&& (int)i >= limit)
+			return false;
+
+		for (unsigned j = 0; j < number_columns; j++)
+		{
+			if (column_widths[j] < row->at(j).length() + 3)
+				column_widths[j] = row->at(j).length() + 3;
+		}
+		return true;
+	});
+
+	return column_widths;
+}
+
+
+/**
+ * returns the current row of qry (graphID, graphOrder, graph, flag1, flag2, ...) with every nonzero flag column set in the flags of the row
+**/
+Graph_row DatabaseInterface::read_row(sqlite3_stmt * qry) {
+	Graph_row row{ sqlite3_column_int(qry, 0), (unsigned)sqlite3_column_int(qry, 1), "", false, 0 };
+	row.edges = read_graph_column(qry, 2, &row.g6);
+
+	for (int i = 3; i < sqlite3_column_count(qry); i++)
+	{
+		if (sqlite3_column_int(qry, i))
+			row.flags |= (uint64_t)1 << (i - 3);
+	}
+
+	return row;
+}
+
+
+/**
+ * writes the values of result into the database by executing stmt with the values bound in order and the graphID bound after them
+ * returns false if result does not provide number_values values
+**/
+bool DatabaseInterface::write_result(sqlite3_stmt * stmt, Graph_result * result, unsigned number_values) {
+	if (!result->update
+		|| result->invalid)
+		return true;
+
+	if (result->values.size() != number_values)
+	{
+		FAIL("Computing values", "There are not the same amounts of values and columns.");
+		return false;
+	}
+
+	for (unsigned j = 0; j < result->values.size(); j++)
+	{
+		if (result->values[j] == NULL_VALUE)
+			sqlite3_bind_null(stmt, j + 1);
+		else
+			sqlite3_bind_int(stmt, j + 1, result->values[j]);
+	}
+
+	sqlite3_bind_int(stmt, result->values.size() + 1, result->graphID);
+
+	sqlite3_step(stmt);
+	sqlite3_reset(stmt);
+
+	return true;
+}
+
+
+/**
+ * evaluates job on chunks of PIPELINE_CHUNK_SIZE graphs selected by qry (graphID, graphOrder, graph, flag1, flag2, ...) in ascending order of graphID and writes the number_values resulting values with stmt
+ * the results are committed every CHECKPOINT_GRAPHS graphs or CHECKPOINT_SECONDS seconds, together with the graphID up to which all graphs are written in the row of jobID in the jobs table (if jobID is not -1)
+ * the row of jobID is deleted once all graphs are processed
+ * with more than one thread, a reader thread streams numbered chunks of rows out of the database, a pool of threads workers evaluates job on them and the calling thread writes the results
+ * the reader and the writer share the connection, so a single thread is used unless the connection is serialized (i.e., has a mutex)
+ * graphs that could not be decoded are reported and not counted
+ * returns the number of graphs processed
+**/
+unsigned DatabaseInterface::process_graphs(sqlite3_stmt * qry, sqlite3_stmt * stmt, Graph_job job, unsigned number_values, unsigned threads, const char * progress, int jobID) {
+	if (sqlite3_threadsafe() == 0
+		|| sqlite3_db_mutex(database) == 0)
+		threads = 1;
+
+	sqlite3_stmt * checkpoint_stmt = 0;
+
+	if (jobID != -1
+		&& sqlite3_prepare_v2(database, "UPDATE Jobs SET lastGraphID = ?, processed = processed + ?, updated = ? WHERE jobID == ?", -1, &checkpoint_stmt, 0) != SQLITE_OK)
+	{
+		SQL_ERROR("UPDATE Jobs SET lastGraphID = ?, processed = processed + ?, updated = ? WHERE jobID == ?");
+		sqlite3_finalize(checkpoint_stmt);
+		checkpoint_stmt = 0;
+	}
+
+	sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
+
+	unsigned processed = 0;
+	unsigned invalid = 0;
+	unsigned checkpointed = 0;
+	int written = 0;
+	bool complete = false;
+	auto last_checkpoint = std::chrono::steady_clock::now();
+
+	auto checkpoint = [this, checkpoint_stmt, jobID, &processed, &checkpointed, &written, &last_checkpoint](bool force) {
+		if (!force
+			&& processed - checkpointed < CHECKPOINT_GRAPHS
+			&& std::chrono::steady_clock::now() - last_checkpoint < std::chrono::seconds(CHECKPOINT_SECONDS))
+			return;
+
+		if (checkpoint_stmt)
+		{
+			std::string datetime = cdatetime();
+			sqlite3_bind_int(checkpoint_stmt, 1, written);
+			sqlite3_bind_int(checkpoint_stmt, 2, processed - checkpointed);
+			sqlite3_bind_text(checkpoint_stmt, 3, datetime.c_str(), datetime.length(), SQLITE_TRANSIENT);
+			sqlite3_bind_int(checkpoint_stmt, 4, jobID);
+			sqlite3_step(checkpoint_stmt);
+			sqlite3_reset(checkpoint_stmt);
+		}
+
+		sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+		sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
+
+		checkpointed = processed;
+		last_checkpoint = std::chrono::steady_clock::now();
+	};
+
+	auto evaluate_chunk = [&job](std::vector<Graph_row> * chunk, std::vector<Graph_result> * chunk_results) {
+		chunk_results->reserve(chunk->size());
+		for (unsigned i = 0; i < chunk->size(); i++)
+			chunk_results->push_back(Graph_result{ chunk->at(i).graphID, false, false, {} });
+
+		job(chunk, chunk_results);
+	};
+
+	if (threads <= 1)
+	{
+		int step = SQLITE_DONE;
+
+		bool failed = false;
+		do
+		{
+			std::vector<Graph_row> chunk;
+			chunk.reserve(PIPELINE_CHUNK_SIZE);
+
+			while (chunk.size() < PIPELINE_CHUNK_SIZE
+				&& (step = sqlite3_step(qry)) == SQLITE_ROW)
+				chunk.push_back(read_row(qry));
+
+			if (chunk.empty())
+				break;
+
+			std::vector<Graph_result> chunk_results;
+			evaluate_chunk(&chunk, &chunk_results);
+
+			for (unsigned i = 0; i < chunk_results.size(); i++)
+			{
+				if (!write_result(stmt, &chunk_results[i], number_values))
+				{
+					failed = true;
+					break;
+				}
+
+				written = chunk_results[i].graphID;
+
+				if (chunk_results[i].invalid)
+					invalid++;
+				else if (++processed % 10000 == 0)
+					PROGRESS(2, 10000 << " " << progress);
+			}
+
+			checkpoint(false);
+		} while (!failed && step == SQLITE_ROW);
+
+		complete = !failed && step == SQLITE_DONE;
+	}
+	else
+	{
+		WorkQueue<std::pair<unsigned, std::vector<Graph_row>>> rows(4 * threads);
+		WorkQueue<std::pair<unsigned, std::vector<Graph_result>>> results(4 * threads);
+		bool read_failed = false;
+
+		std::thread reader([&rows, &read_failed, qry, this] {
+			sqlite3_mutex * mutex = sqlite3_db_mutex(database);
+			unsigned number = 0;
+			bool done = false;
+			while (!done)
+			{
+				std::vector<Graph_row> chunk;
+				chunk.reserve(PIPELINE_CHUNK_SIZE);
+
+				while (chunk.size() < PIPELINE_CHUNK_SIZE)
+				{
+					sqlite3_mutex_enter(mutex);
+					int step = sqlite3_step(qry);
+					if (step == SQLITE_ROW)
+						chunk.push_back(read_row(qry));
+					else
+					{
+						read_failed = step != SQLITE_DONE;
+						done = true;
+					}
+					sqlite3_mutex_leave(mutex);
+
+					if (done)
+						break;
+				}
+
+				if (!chunk.empty() && !rows.push(std::make_pair(number++, std::move(chunk))))
+					break;
+			}
+			rows.close();
+		});
+
+		std::atomic<unsigned> running_workers(threads);
+		std::vector<std::thread> workers;
+
+		for (unsigned t = 0; t < threads; t++)
+			workers.push_back(std::thread([&rows, &results, &running_workers, &evaluate_chunk] {
+				std::pair<unsigned, std::vector<Graph_row>> chunk;
+				while (rows.pop(&chunk))
+				{
+					std::vector<Graph_result> chunk_results;
+					evaluate_chunk(&chunk.second, &chunk_results);
+
+					if (!results.push(std::make_pair(chunk.first, std::move(chunk_results))))
+						break;
+				}
+
+				if (--running_workers == 0)
+					results.close();
+			}));
+
+		// chunks are written in the order they are finished, graphs up to the last graphID of the longest run of consecutive written chunks are written completely
+		std::map<unsigned, int> finished_chunks;
+		unsigned next_chunk = 0;
+
+		std::pair<unsigned, std::vector<Graph_result>> chunk_results;
+		bool failed = false;
+		while (!failed && results.pop(&chunk_results))
+		{
+			for (unsigned i = 0; i < chunk_results.second.size(); i++)
+			{
+				if (!write_result(stmt, &chunk_results.second[i], number_values))
+				{
+					failed = true;
+					rows.cancel();
+					results.cancel();
+					break;
+				}
+
+				if (chunk_results.second[i].invalid)
+					invalid++;
+				else if (++processed % 10000 == 0)
+					PROGRESS(2, 10000 << " " << progress);
+			}
+
+			if (failed)
+				break;
+
+			finished_chunks[chunk_results.first] = chunk_results.second.back().graphID;
+			while (finished_chunks.count(next_chunk))
+			{
+				written = finished_chunks[next_chunk];
+				finished_chunks.erase(next_chunk++);
+			}
+
+			checkpoint(false);
+		}
+
+		reader.join();
+		for (unsigned t = 0; t < threads; t++)
+			workers[t].join();
+
+		complete = !failed && !read_failed;
+	}
+
+	checkpoint(true);
+
+	if (complete
+		&& jobID != -1)
+		sqlite3_exec(database, ("DELETE FROM Jobs WHERE jobID == " + std::to_string(jobID) + ";").c_str(), 0, 0, 0);
+
+	sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+	sqlite3_finalize(checkpoint_stmt);
+
+	if (processed % 10000 != 0)
+		PROGRESS(2, processed % 10000 << " " << progress);
+
+	if (invalid != 0)
+		FAIL("Reading graphs", invalid << " graphs could not be decoded, nothing was written for them.");
+
+	return processed;
+}
+
+
 //########## public member functions ##########
 /**
  * resets all member variables excepts the database itself
 **/
 void DatabaseInterface::reset_view() {
 	number_columns = 0;
-	number_rows = 0;
+	view_query = "";
 	view_columns = {};
-	view_contents = {};
-	column_widths = {};
+	view_cache = {};
+	view_complete = true;
+	view_changes = 0;
+	view_data_version = "";
+}
+
+
+/**
+ * tests if the rows of the current view up to given limit (all rows if it is -1) can be read
+ * rows beyond the cached ones are read by executing the query of the view again and skipping the cached ones, which is only consistent if the database has not changed since the view was created
+**/
+bool DatabaseInterface::check_view(int limit) {
+	if (view_complete
+		|| (limit != -1 && (unsigned)limit <= view_cache.size()))
+		return true;
+
+	if (sqlite3_total_changes(database) != view_changes
+		|| get_pragma("data_version") != view_data_version)
+	{
+		FAIL("Reading view", "The database has changed since the view was created, so only its first " << view_cache.size() << " rows are still available. Execute the query again to read all of them.");
+		return false;
+	}
+
+	return true;
 }
 
 
@@ -67,8 +755,11 @@ void DatabaseInterface::reset_view() {
  * outputs the current view to the terminal by iterating over all rows (until the limit is reached) in the current view
 **/
 void DatabaseInterface::show_view(int limit) {
-	if (number_columns != 0)
+	if (number_columns != 0
+		&& check_view(limit))
 	{
+		std::vector<unsigned> column_widths = get_column_widths(limit);
+
 		for (unsigned j = 0; j < number_columns; j++)
 			std::cout << std::string(column_widths[j], '_');
 		std::cout << "\n";
@@ -81,19 +772,19 @@ void DatabaseInterface::show_view(int limit) {
 			std::cout << std::string(column_widths[j], '_');
 		std::cout << "\n";
 
-		for (int i = 0; i < (int)number_rows; i++)
-		{
+		step_view([this, limit, &column_widths](unsigned i, std::vector<std::string> * row) {
 			if (limit != -1
-				&& i >= limit)
+				&& (int)i >= limit)
 			{
 				std::cout << "\n ... [View exceeds " << limit << " rows. For the complete list please save as text file or show view with higher limit.]\n";
-				break;
+				return false;
 			}
 
 			for (unsigned j = 0; j < number_columns - 1; j++)
-				std::cout << view_contents[i][j] << std::string(column_widths[j] - view_contents[i][j].length(), ' ');
-			std::cout << view_contents[i][number_columns - 1] << "\n";
-		}
+				std::cout << row->at(j) << std::string(column_widths[j] - row->at(j).length(), ' ');
+			std::cout << row->at(number_columns - 1) << "\n";
+			return true;
+		});
 	}
 
 	std::cout << std::endl;
@@ -104,8 +795,11 @@ void DatabaseInterface::show_view(int limit) {
 * outputs the current view to given file by iterating over all rows in the current view
 **/
 void DatabaseInterface::save_view(std::ofstream * file) {
-	if (number_columns != 0)
+	if (number_columns != 0
+		&& check_view(-1))
 	{
+		std::vector<unsigned> column_widths = get_column_widths(-1);
+
 		for (unsigned j = 0; j < number_columns; j++)
 			*file << std::string(column_widths[j], '_');
 		*file << "\n";
@@ -118,12 +812,12 @@ void DatabaseInterface::save_view(std::ofstream * file) {
 			*file << std::string(column_widths[j], '_');
 		*file << "\n";
 
-		for (unsigned i = 0; i < number_rows; i++)
-		{
+		step_view([this, file, &column_widths](unsigned i, std::vector<std::string> * row) {
 			for (unsigned j = 0; j < number_columns - 1; j++)
-				*file << view_contents[i][j] << std::string(column_widths[j] - view_contents[i][j].length(), ' ');
-			*file << view_contents[i][number_columns - 1] << "\n";
-		}
+				*file << row->at(j) << std::string(column_widths[j] - row->at(j).length(), ' ');
+			*file << row->at(number_columns - 1) << "\n";
+			return true;
+		});
 	}
 }
 
@@ -133,8 +827,10 @@ void DatabaseInterface::save_view(std::ofstream * file) {
 * all data with 'Bettis' in its column name will be printed as tables
 **/
 void DatabaseInterface::show_view_rich(int limit) {
-	if (number_columns != 0)
+	if (number_columns != 0
+		&& check_view(limit))
 	{
+		std::vector<unsigned> column_widths = get_column_widths(limit);
 		std::vector<unsigned> matrix_indices;
 		std::vector<std::string> table_names;
 		std::string columns = "";
@@ -159,20 +855,17 @@ void DatabaseInterface::show_view_rich(int limit) {
 			}
 		}
 
-		unsigned index;
-
-		for (int i = 0; i < (int)number_rows; i++)
-		{
+		step_view([&](unsigned i, std::vector<std::string> * view_row) {
 			if (limit != -1
-				&& i >= limit)
+				&& (int)i >= limit)
 			{
 				std::cout << "\n ... [View exceeds " << limit << " rows. For the complete list please save as text file or show view with higher limit.]\n";
-				break;
+				return false;
 			}
 
 			std::cout << std::string(overall_width, '_') << "\n" << columns << "\n";
 
-			index = 0;
+			unsigned index = 0;
 			std::vector<BettiTable> tables;
 			std::string row = "";
 
@@ -183,14 +876,14 @@ void DatabaseInterface::show_view_rich(int limit) {
 				if (index < matrix_indices.size() && j == matrix_indices[index])
 				{
 					BettiTable b;
-					b.read_from_line(&view_contents[i][j]);
+					b.read_from_line(&view_row->at(j));
 					tables.push_back(b);
 					index++;
 				}
 				else
 				{
-					row += std::string(last_whitespace, ' ') + view_contents[i][j];
-					last_whitespace = column_widths[j] - view_contents[i][j].length();
+					row += std::string(last_whitespace, ' ') + view_row->at(j);
+					last_whitespace = column_widths[j] - view_row->at(j).length();
 				}
 			}
 			std::cout << row << "\n";
@@ -199,7 +892,8 @@ void DatabaseInterface::show_view_rich(int limit) {
 				std::cout << "\n";
 
 			std::cout << BettiTable::convert_tables_to_string(&tables, &table_names);
-		}
+			return true;
+		});
 	}
 
 	std::cout << std::endl;
@@ -211,8 +905,10 @@ void DatabaseInterface::show_view_rich(int limit) {
 * all data with 'Bettis' in its column name will be printed as tables
 **/
 void DatabaseInterface::save_view_rich(std::ofstream * file) {
-	if (number_columns != 0)
+	if (number_columns != 0
+		&& check_view(-1))
 	{
+		std::vector<unsigned> column_widths = get_column_widths(-1);
 		std::vector<unsigned> matrix_indices;
 		std::vector<std::string> table_names;
 		std::string columns = "";
@@ -237,13 +933,10 @@ void DatabaseInterface::save_view_rich(std::ofstream * file) {
 			}
 		}
 
-		unsigned index;
-
-		for (int i = 0; i < (int)number_rows; i++)
-		{
+		step_view([&](unsigned i, std::vector<std::string> * view_row) {
 			*file << std::string(overall_width, '_') << "\n" << columns << "\n";
 
-			index = 0;
+			unsigned index = 0;
 			std::vector<BettiTable> tables;
 			std::string row = "";
 
@@ -254,14 +947,14 @@ void DatabaseInterface::save_view_rich(std::ofstream * file) {
 				if (index < matrix_indices.size() && j == matrix_indices[index])
 				{
 					BettiTable b;
-					b.read_from_line(&view_contents[i][j]);
+					b.read_from_line(&view_row->at(j));
 					tables.push_back(b);
 					index++;
 				}
 				else
 				{
-					row += std::string(last_whitespace, ' ') + view_contents[i][j];
-					last_whitespace = column_widths[j] - view_contents[i][j].length();
+					row += std::string(last_whitespace, ' ') + view_row->at(j);
+					last_whitespace = column_widths[j] - view_row->at(j).length();
 				}
 			}
 			*file << row << "\n";
@@ -270,7 +963,8 @@ void DatabaseInterface::save_view_rich(std::ofstream * file) {
 				*file << "\n";
 
 			*file << BettiTable::convert_tables_to_string(&tables, &table_names);
-		}
+			return true;
+		});
 	}
 }
 
@@ -282,6 +976,7 @@ void DatabaseInterface::save_view_visualisation(std::ofstream * file) {
 	int graphID_index = -1;
 	int graphOrder_index = -1;
 	int edges_index = -1;
+	int g6_index = -1;
 
 	for (unsigned i = 0; i < number_columns; i++)
 	{
@@ -315,12 +1010,22 @@ void DatabaseInterface::save_view_visualisation(std::ofstream * file) {
 				return;
 			}
 		}
+		else if (view_columns[i] == "g6")
+		{
+			if (g6_index == -1)
+				g6_index = i;
+			else
+			{
+				FAIL("Saving view", "Visualisation does not support multiple graphs per row.");
+				return;
+			}
+		}
 	}
 
-	if (graphOrder_index == -1
-		|| edges_index == -1)
+	if (g6_index == -1
+		&& (graphOrder_index == -1 || edges_index == -1))
 	{
-		FAIL("Saving view", "View does not include both graphOrder and edges. These are necessary to visualize the graphs.");
+		FAIL("Saving view", "View does not include g6 or both graphOrder and edges. These are necessary to visualize the graphs.");
 		return;
 	}
 
@@ -329,23 +1034,31 @@ void DatabaseInterface::save_view_visualisation(std::ofstream * file) {
 		"\\usepackage{tikz}\n\\usetikzlibrary{ decorations.pathreplacing }\n\\usetikzlibrary{ shapes.misc }\n\\usetikzlibrary{ calc }\n" \
 		"\n%%########## document code ##########\n\n";
 
-	for (unsigned i = 0; i < number_rows; i++)
-	{
+	step_view([&](unsigned i, std::vector<std::string> * row) {
+		Graph g;
+		if (g6_index != -1
+			&& row->at(g6_index) != "-")
+			g.read_graph_from_g6(&row->at(g6_index));
+		else if (graphOrder_index != -1
+			&& edges_index != -1)
+			g.read_graph_from_line(str_to_unsigned(&row->at(graphOrder_index)), &row->at(edges_index));
+		else
+		{
+			FAIL("Saving view", "View does not include both graphOrder and edges of a graph without g6.");
+			return false;
+		}
+
+		unsigned graphOrder = g.get_order();
+
 		std::string info = "";
 		if (graphID_index != -1)
-			info += view_columns[graphID_index] + ": " + view_contents[i][graphID_index] + ", ";
+			info += view_columns[graphID_index] + ": " + row->at(graphID_index) + ", ";
 		else
 			info += "Graph " + std::to_string(i + 1) + ", ";
-		info += view_columns[graphOrder_index] + ": " + view_contents[i][graphOrder_index];
+		info += "graphOrder: " + std::to_string(graphOrder);
 		info += "\n\n\\begin{center}\n\\begin{tikzpicture}[\nscale=0.04,mynode/.style={draw,fill=white,circle,outer sep=4pt,inner sep=2pt},myedge/.style={line width=1.5,black}\n]\n";
 		*file << info;
 
-		unsigned graphOrder;
-		std::stringstream order_stream(view_contents[i][graphOrder_index]);
-		order_stream >> graphOrder;
-
-		Graph g(graphOrder, &view_contents[i][edges_index]);
-
 		std::string coordinates = "";
 		std::string edges = "";
 		std::string vertices = "";
@@ -372,7 +1085,8 @@ void DatabaseInterface::save_view_visualisation(std::ofstream * file) {
 		}
 
 		*file << coordinates << edges << vertices << info;
-	}
+		return true;
+	});
 }
 
 
@@ -382,6 +1096,7 @@ void DatabaseInterface::save_view_visualisation(std::ofstream * file) {
 void DatabaseInterface::save_view_g6(std::ofstream * file) {
 	int graphOrder_index = -1;
 	int edges_index = -1;
+	int g6_index = -1;
 
 	for (unsigned j = 0; j < number_columns; j++)
 	{
@@ -389,122 +1104,264 @@ void DatabaseInterface::save_view_g6(std::ofstream * file) {
 			graphOrder_index = j;
 		else if (view_columns[j] == "edges")
 			edges_index = j;
+		else if (view_columns[j] == "g6")
+			g6_index = j;
 	}
 
-	if (graphOrder_index == -1
-		|| edges_index == -1)
+	if (g6_index == -1
+		&& (graphOrder_index == -1 || edges_index == -1))
 	{
-		FAIL("Saving view", "View does not include both graphOrder and edges. These are necessary to visualize the graphs.");
+		FAIL("Saving view", "View does not include g6 or both graphOrder and edges. These are necessary to save the graphs.");
 		return;
 	}
 
-	for (unsigned i = 0; i < number_rows; i++)
-	{
+	step_view([&](unsigned i, std::vector<std::string> * row) {
+		if (g6_index != -1
+			&& row->at(g6_index) != "-")
+		{
+			*file << row->at(g6_index) << "\n";
+			return true;
+		}
+
+		if (graphOrder_index == -1
+			|| edges_index == -1)
+		{
+			FAIL("Saving view", "View does not include both graphOrder and edges of a graph without g6.");
+			return false;
+		}
+
 		Graph g;
-		g.read_graph_from_line(str_to_unsigned(&view_contents[i][graphOrder_index]), &view_contents[i][edges_index]);
+		g.read_graph_from_line(str_to_unsigned(&row->at(graphOrder_index)), &row->at(edges_index));
 
 		*file << g.convert_to_g6_format() << "\n";
-	}
+		return true;
+	});
 }
 
 
 /**
 * generates Macaulay2 scripts of all graphs satisfying query_condition, based on template filename, each labeled wrt to the labeling induced by ordering ordering_name
 * for this, the function queries the database and iterates over all results printing the graphs into files based on the template
+* every script also lists the graphIDs of its graphs as graphIDs, so that the template can write them in front of the results
+* graphs that cannot be decoded are left out of the scripts and reported
+* without cost_model, every script gets batch_size graphs in the order of the query
+* with cost_model (an SQL expression estimating the cost of a graph, the default one if empty), there are as many scripts as with batch_size, but each graph goes to the script of least estimated cost so far, most expensive graphs first
 * function also registers the generated scripts in the scripts table so that results may be imported later
 **/
-void DatabaseInterface::generate_m2_scripts(std::string * name, unsigned * (Graph::*gen_ordering)(), unsigned batch_size, const char * query_condition, const char * filename, const char * ordering_name, unsigned index) {
+void DatabaseInterface::generate_m2_scripts(std::string * name, unsigned * (Graph::*gen_ordering)(), unsigned batch_size, const char * query_condition, const char * filename, const char * ordering_name, unsigned index, const char * cost_model) {
+	std::string cost = cost_model ? cost_model : "";
+	if (cost_model
+		&& cost.empty())
+		cost = get_default_cost_model();
+
+	std::string query = "SELECT graphID,graphOrder," GRAPH_COLUMN;
+	if (cost_model)
+		query += ",(" + cost + ")";
+	query += " FROM Graphs";
+	if (query_condition)
+		query += " WHERE " + std::string(query_condition);
+	if (cost_model)
+		query += " ORDER BY 4 DESC";
+
 	sqlite3_stmt * qry;
 
-	if (query_condition)
+	if (sqlite3_prepare_v2(database, query.c_str(), -1, &qry, 0) != SQLITE_OK)
 	{
-		if (sqlite3_prepare_v2(database, ("SELECT graphOrder,edges FROM Graphs WHERE " + std::string(query_condition)).c_str(), -1, &qry, 0) != SQLITE_OK)
-		{
-			FAIL("Generating M2 scripts", "SQL error: '" << "SELECT graphOrder,edges FROM Graphs WHERE " << query_condition << "' is an invalid query.");
-			sqlite3_finalize(qry);
-			return;
-		}
+		FAIL("Generating M2 scripts", "SQL error: '" << query << "' is an invalid query.");
+		sqlite3_finalize(qry);
+		return;
 	}
-	else
+
+	std::string default_filename = "template_" + *name + "_" + std::to_string(index) + ".m2";
+	std::ifstream templ(filename ? filename : default_filename);
+
+	if (!templ.is_open())
 	{
-		if (sqlite3_prepare_v2(database, "SELECT graphOrder,edges FROM Graphs", -1, &qry, 0) != SQLITE_OK)
+		FAIL("Generating M2 scripts", "Unable to open '" << (filename ? filename : default_filename) << "'.");
+		sqlite3_finalize(qry);
+		return;
+	}
+
+	std::stringstream buffer;
+	buffer << templ.rdbuf();
+	templ.close();
+
+	std::string datetime(cdatetime());
+
+	unsigned skipped = 0;
+
+	// changes line to the graph of the current row of qry, returns false (counting it as skipped) if it cannot be decoded
+	auto read_graph_line = [qry, gen_ordering, &skipped](std::string * line) {
+		bool g6;
+		std::string edges = read_graph_column(qry, 2, &g6);
+
+		Graph g;
+		if (!read_graph(&g, sqlite3_column_int(qry, 1), &edges, g6))
 		{
-			FAIL("Generating M2 scripts", "SQL error: 'SELECT graphOrder,edges FROM Graphs' is an invalid query.");
-			sqlite3_finalize(qry);
-			return;
+			skipped++;
+			return false;
+		}
+
+		if (!gen_ordering)
+		{
+			*line = g.convert_to_string() + ",\n";
+			return true;
+		}
+
+		unsigned * ordering = (g.*gen_ordering)();
+		*line = g.convert_to_string_wrt_ordering(ordering) + ",\n";
+		delete[] ordering;
+		return true;
+	};
+
+	auto write_script = [&datetime, &buffer, name, index](unsigned k, std::string * graphs, std::string * ids, unsigned number) {
+		if (number == 0)
+		{
+			FAIL("Generating M2 scripts", "Script " << k << " would contain no graphs.");
+			return false;
+		}
+
+		std::string script = "G = {\n" + *graphs;
+		script.pop_back();
+		script.pop_back();
+		ids->pop_back();
+		script += "\n};\n\ngraphIDs = {" + *ids + "};\n\nfilename=\"" + std::to_string(index) + "_" + datetime + "_" + *name + "_" + std::to_string(k) + ".result\";\nN=" + std::to_string(number) + ";\n\n" + buffer.str();
+
+		std::string filename = std::to_string(index) + "_" + datetime + "_" + *name + "_" + std::to_string(k) + ".m2";
+		std::ofstream kFile(filename, std::ios::trunc);
+
+		if (!kFile.is_open())
+		{
+			FAIL("Generating M2 scripts", "Unable to write to file '" << filename << "'.");
+			return false;
 		}
-	}
-
-	std::string default_filename = "template_" + *name + "_" + std::to_string(index) + ".m2";
-	std::ifstream templ(filename ? filename : default_filename);
 
-	if (!templ.is_open())
-	{
-		FAIL("Generating M2 scripts", "Unable to open '" << (filename ? filename : default_filename) << "'.");
-		sqlite3_finalize(qry);
-		return;
-	}
+		kFile << script;
 
-	std::stringstream buffer;
-	buffer << templ.rdbuf();
-	templ.close();
+		kFile.close();
 
-	std::string datetime(cdatetime());
+		PROGRESS(2, "generated '" << filename << "'");
+		return true;
+	};
 
-	unsigned k;
-	unsigned i;
+	unsigned batches = 0;
 
-	for (k = 0; true; k++)
+	if (!cost_model)
 	{
-		std::string script = "G = {\n";
-		std::string edges;
+		bool done = false;
 
-		for (i = 0; i < batch_size && sqlite3_step(qry) == SQLITE_ROW; i++)
+		for (unsigned k = 0; !done; k++)
 		{
-			edges = (char *)sqlite3_column_text(qry, 1) ? (char *)sqlite3_column_text(qry, 1) : "ERROR";
-			Graph g(sqlite3_column_int(qry, 0), &edges);
+			std::string graphs = "";
+			std::string ids = "";
+			std::string line;
+			unsigned i = 0;
 
-			if (gen_ordering)
+			while (i < batch_size
+				&& !(done = sqlite3_step(qry) != SQLITE_ROW))
 			{
-				unsigned * ordering = (g.*gen_ordering)();
-				script += g.convert_to_string_wrt_ordering(ordering) + ",\n";
-				delete[] ordering;
+				if (!read_graph_line(&line))
+					continue;
+
+				ids += std::to_string(sqlite3_column_int(qry, 0)) + ",";
+				graphs += line;
+				i++;
 			}
-			else
-				script += g.convert_to_string() + ",\n";
+
+			if (i == 0)
+				break;
+
+			if (!write_script(k, &graphs, &ids, i))
+			{
+				sqlite3_finalize(qry);
+				return;
+			}
+			batches++;
 		}
+	}
+	else
+	{
+		std::string count_query = "SELECT COUNT(*) FROM Graphs";
+		if (query_condition)
+			count_query += " WHERE " + std::string(query_condition);
+
+		sqlite3_stmt * count;
+		if (sqlite3_prepare_v2(database, count_query.c_str(), -1, &count, 0) == SQLITE_OK
+			&& sqlite3_step(count) == SQLITE_ROW)
+			batches = (sqlite3_column_int(count, 0) + batch_size - 1) / batch_size;
+		sqlite3_finalize(count);
+
+		std::vector<std::string> graphs(batches, "");
+		std::vector<std::string> ids(batches, "");
+		std::vector<unsigned> numbers(batches, 0);
+		std::vector<double> costs(batches, 0);
+
+		// batches ordered by estimated cost so far, the cheapest one on top
+		std::priority_queue<std::pair<double, unsigned>, std::vector<std::pair<double, unsigned>>, std::greater<std::pair<double, unsigned>>> cheapest;
+		for (unsigned k = 0; k < batches; k++)
+			cheapest.push(std::make_pair(0.0, k));
+
+		std::string line;
 
+		while (batches > 0
+			&& sqlite3_step(qry) == SQLITE_ROW)
+		{
+			if (!read_graph_line(&line))
+				continue;
 
+			unsigned k = cheapest.top().second;
+			cheapest.pop();
 
-		script.pop_back();
-		script.pop_back();
-		script += "\n};\n\nfilename=\"" + std::to_string(index) + "_" + datetime + "_" + *name + "_" + std::to_string(k) + ".result\";\nN=" + std::to_string(i) + ";\n\n" + buffer.str();
+			ids[k] += std::to_string(sqlite3_column_int(qry, 0)) + ",";
+			graphs[k] += line;
+			numbers[k]++;
 
-		std::string filename = std::to_string(index) + "_" + datetime + "_" + *name + "_" + std::to_string(k) + ".m2";
-		std::ofstream kFile(filename, std::ios::trunc);
+			// costs that are not positive (or NULL) count as 1, so such graphs are spread evenly instead of all going to the same script
+			costs[k] += std::max(sqlite3_column_double(qry, 3), 1.0);
+			cheapest.push(std::make_pair(costs[k], k));
+		}
 
-		if (!kFile.is_open())
+		// scripts left empty (if fewer graphs were found or decoded than counted) are dropped, the others keep their order
+		unsigned filled = 0;
+		for (unsigned k = 0; k < batches; k++)
 		{
-			FAIL("Generating M2 scripts", "Unable to write to file '" << filename << "'.");
-			sqlite3_finalize(qry);
-			return;
+			if (numbers[k] == 0)
+				continue;
+
+			if (filled != k)
+			{
+				graphs[filled] = std::move(graphs[k]);
+				ids[filled] = std::move(ids[k]);
+				numbers[filled] = numbers[k];
+				costs[filled] = costs[k];
+			}
+			filled++;
 		}
 
-		kFile << script;
+		batches = filled;
+		costs.resize(batches);
 
-		kFile.close();
-		
-		PROGRESS(2, "generated '" << filename << "'");
+		for (unsigned k = 0; k < batches; k++)
+		{
+			if (!write_script(k, &graphs[k], &ids[k], numbers[k]))
+			{
+				sqlite3_finalize(qry);
+				return;
+			}
+		}
 
-		if (i < batch_size)
-			break;
+		if (batches > 0)
+			PROGRESS(2, "estimated costs of the scripts range from " << *std::min_element(costs.begin(), costs.end()) << " to " << *std::max_element(costs.begin(), costs.end()));
 	}
 
 	sqlite3_finalize(qry);
 
-	if (k == 0 && i == 0)
+	if (skipped != 0)
+		FAIL("Reading graphs", skipped << " graphs could not be decoded, they were left out of the scripts.");
+
+	if (batches == 0)
 	{
-		FAIL("Generating M2 scripts", "Unable to find any graphs satisfying the condition of the query: '" << qry << "'.");
+		FAIL("Generating M2 scripts", "Unable to find any graphs satisfying the condition of the query: '" << query << "'.");
 		return;
 	}
 
@@ -518,8 +1375,8 @@ void DatabaseInterface::generate_m2_scripts(std::string * name, unsigned * (Grap
 		values += "\"" + std::string(ordering_name) + "\",";
 	}
 
-	columns += "batchsize,";
-	values += std::to_string(batch_size) + ",";
+	columns += "batchsize,batches,";
+	values += std::to_string(batch_size) + "," + std::to_string(batches) + ",";
 
 	if (query_condition)
 	{
@@ -527,6 +1384,12 @@ void DatabaseInterface::generate_m2_scripts(std::string * name, unsigned * (Grap
 		values += "\"" + std::string(query_condition) + "\",";
 	}
 
+	if (cost_model)
+	{
+		columns += "costModel,";
+		values += "\"" + cost + "\",";
+	}
+
 	values += "\"" + datetime + "\"," + std::to_string(index) + ")";
 	columns += values;
 
@@ -535,14 +1398,14 @@ void DatabaseInterface::generate_m2_scripts(std::string * name, unsigned * (Grap
 
 
 /**
-* outputs the status table to the terminal
+* outputs the complete result of query to the terminal (without changing the current view), NULL is shown as '-'
 **/
-void DatabaseInterface::show_scripts() {
+void DatabaseInterface::print_table(const char * query) {
 	sqlite3_stmt * stmt;
 
-	if (sqlite3_prepare_v2(database, "SELECT * FROM Scripts", -1, &stmt, 0) != SQLITE_OK)
+	if (sqlite3_prepare_v2(database, query, -1, &stmt, 0) != SQLITE_OK)
 	{
-		SQL_ERROR("SELECT * FROM Scripts");
+		SQL_ERROR(query);
 		sqlite3_finalize(stmt);
 		return;
 	}
@@ -607,9 +1470,26 @@ void DatabaseInterface::show_scripts() {
 }
 
 
+/**
+* outputs the status table to the terminal, including the number of batches done by 'run' and their total runtime (in seconds)
+**/
+void DatabaseInterface::show_scripts() {
+	print_table("SELECT Scripts.*," SCRIPT_PROGRESS " FROM Scripts");
+}
+
+
+/**
+* outputs the table of interrupted compute and classify jobs to the terminal
+**/
+void DatabaseInterface::show_jobs() {
+	print_table("SELECT * FROM Jobs");
+}
+
+
 /**
  * expects a SELECT SQL-statement
- * tries to execute query, save the result and output the view to the terminal
+ * tries to execute query, keep its first rows in memory as the current view and output the view to the terminal
+ * further rows of the view are not kept, but streamed from the database whenever they are needed
 **/
 bool DatabaseInterface::execute_SQL_query(std::string * query) {
 	if (query->empty())
@@ -628,32 +1508,32 @@ bool DatabaseInterface::execute_SQL_query(std::string * query) {
 
 		reset_view();
 
+		view_query = *query;
 		number_columns = sqlite3_column_count(stmt);
 
 		for (unsigned i = 0; i < number_columns; i++)
-		{
-			std::string column = sqlite3_column_name(stmt, i);
-			view_columns.push_back(column);
-			column_widths.push_back(column.length() + 3);
-		}
+			view_columns.push_back(sqlite3_column_name(stmt, i));
 
-		while (sqlite3_step(stmt) == SQLITE_ROW)
+		view_complete = false;
+		int step = SQLITE_ROW;
+		while (!view_complete
+			&& view_cache.size() < VIEW_CACHE_SIZE)
 		{
-			std::vector<std::string> row;
-			for (unsigned i = 0; i < number_columns; i++)
-			{
-				std::string content = (char *)sqlite3_column_text(stmt, i) ? (char *)sqlite3_column_text(stmt, i) : "-";
-				row.push_back(content);
-
-				if (column_widths[i] < content.length() + 3)
-					column_widths[i] = content.length() + 3;
-			}
-			view_contents.push_back(row);
-			number_rows++;
+			if ((step = sqlite3_step(stmt)) == SQLITE_ROW)
+				view_cache.push_back(read_view_row(stmt));
+			else
+				view_complete = true;
 		}
 
+		if (step != SQLITE_ROW
+			&& step != SQLITE_DONE)
+			FAIL("SQL query", sqlite3_errmsg(database) << ". Only the rows before the error are in the view.");
+
 		sqlite3_finalize(stmt);
 
+		view_changes = sqlite3_total_changes(database);
+		view_data_version = get_pragma("data_version");
+
 		show_view();
 	}
 	catch (const char * error)
@@ -685,139 +1565,529 @@ bool DatabaseInterface::execute_SQL_statement(std::string * statement) {
 }
 
 
-/**
-* creates the script table in the database for ensuring database consistency
-**/
-bool DatabaseInterface::create_scripts_table() {
-	std::string statement = "CREATE TABLE Scripts(" \
-		"scriptID INTEGER PRIMARY KEY," \
-		"name TEXT NOT NULL," \
-		"ordering TEXT," \
-		"batchsize INT NOT NULL," \
-		"condition TEXT," \
-		"datetime TEXT NOT NULL," \
-		"resultType INT NOT NULL" \
-		");";
+/**
+* creates the script table in the database for ensuring database consistency
+* an existing table of an older version gets the batches and costModel columns instead
+* the batches table keeps the status, number of attempts and runtime of every batch run by 'run'
+**/
+bool DatabaseInterface::create_scripts_table() {
+	sqlite3_exec(database, "CREATE TABLE IF NOT EXISTS Batches(" \
+		"scriptID INT NOT NULL," \
+		"batch INT NOT NULL," \
+		"status TEXT NOT NULL," \
+		"attempts INT NOT NULL DEFAULT 0," \
+		"runtime REAL," \
+		"PRIMARY KEY(scriptID,batch)" \
+		");", 0, 0, 0);
+
+	std::string statement = "CREATE TABLE Scripts(" \
+		"scriptID INTEGER PRIMARY KEY," \
+		"name TEXT NOT NULL," \
+		"ordering TEXT," \
+		"batchsize INT NOT NULL," \
+		"batches INT," \
+		"condition TEXT," \
+		"costModel TEXT," \
+		"datetime TEXT NOT NULL," \
+		"resultType INT NOT NULL" \
+		");";
+
+	if (sqlite3_exec(database, statement.c_str(), 0, 0, 0) != SQLITE_OK)
+	{
+		sqlite3_exec(database, "ALTER TABLE Scripts ADD batches INT;", 0, 0, 0);
+		sqlite3_exec(database, "ALTER TABLE Scripts ADD costModel TEXT;", 0, 0, 0);
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+* creates the jobs table in the database, which keeps every compute and classify job until it is complete
+* lastGraphID is the graphID up to which all graphs are processed and committed, so an interrupted job can be resumed after it
+**/
+bool DatabaseInterface::create_jobs_table() {
+	std::string statement = "CREATE TABLE IF NOT EXISTS Jobs(" \
+		"jobID INTEGER PRIMARY KEY," \
+		"command TEXT NOT NULL," \
+		"lastGraphID INT NOT NULL DEFAULT 0," \
+		"processed INT NOT NULL DEFAULT 0," \
+		"started TEXT NOT NULL," \
+		"updated TEXT" \
+		");";
+
+	return sqlite3_exec(database, statement.c_str(), 0, 0, 0) == SQLITE_OK;
+}
+
+
+/**
+* registers a job running the given command (e.g., 'classify -closed') in the jobs table
+* returns its jobID or -1 if it could not be registered
+**/
+int DatabaseInterface::create_job(std::string * command) {
+	sqlite3_stmt * stmt;
+
+	if (sqlite3_prepare_v2(database, "INSERT INTO Jobs (command,started) VALUES (?,?)", -1, &stmt, 0) != SQLITE_OK)
+	{
+		SQL_ERROR("INSERT INTO Jobs (command,started) VALUES (?,?)");
+		sqlite3_finalize(stmt);
+		return -1;
+	}
+
+	std::string datetime = cdatetime();
+	sqlite3_bind_text(stmt, 1, command->c_str(), command->length(), SQLITE_STATIC);
+	sqlite3_bind_text(stmt, 2, datetime.c_str(), datetime.length(), SQLITE_STATIC);
+
+	int jobID = sqlite3_step(stmt) == SQLITE_DONE ? (int)sqlite3_last_insert_rowid(database) : -1;
+	sqlite3_finalize(stmt);
+
+	return jobID;
+}
+
+
+/**
+* changes command and last_graphID to those of the job with given jobID
+* returns false if there is no such job
+**/
+bool DatabaseInterface::find_job(int jobID, std::string * command, int * last_graphID) {
+	sqlite3_stmt * qry;
+
+	if (sqlite3_prepare_v2(database, ("SELECT command,lastGraphID FROM Jobs WHERE jobID == " + std::to_string(jobID)).c_str(), -1, &qry, 0) != SQLITE_OK)
+	{
+		SQL_ERROR("SELECT command,lastGraphID FROM Jobs WHERE jobID == " << jobID);
+		sqlite3_finalize(qry);
+		return false;
+	}
+
+	if (sqlite3_step(qry) != SQLITE_ROW)
+	{
+		sqlite3_finalize(qry);
+		return false;
+	}
+
+	*command = (char *)sqlite3_column_text(qry, 0);
+	*last_graphID = sqlite3_column_int(qry, 1);
+	sqlite3_finalize(qry);
+
+	return true;
+}
+
+
+/**
+ * creates graphs table in the database
+ * the types of a graph are stored in typeMask, bit i being set iff the graph is of types[i], every type also gets a (virtual) boolean column
+ * bit i of testedMask is set iff the graph has been tested for types[i], so negative results are kept as well
+ * the canonical Graph6 of a graph, a certificate of its isomorphism class, is stored in canonical by deduplicating imports
+ * types stored as text in the type column of older tables are moved into typeMask
+**/
+bool DatabaseInterface::create_graphs_table(std::vector<const char *> * types) {
+	std::string statement = "CREATE TABLE IF NOT EXISTS Graphs("  \
+							"graphID INTEGER PRIMARY KEY," \
+							"graphOrder INT NOT NULL," \
+							"graphSize INT NOT NULL," \
+							"edges TEXT," \
+							"g6 BLOB," \
+							"typeMask INT NOT NULL DEFAULT 0," \
+							"testedMask INT NOT NULL DEFAULT 0," \
+							"canonical BLOB" \
+							");";
+
+	if (!execute_SQL_statement(&statement))
+		return false;
+
+	sqlite3_exec(database, "ALTER TABLE Graphs ADD g6 BLOB;", 0, 0, 0);
+	sqlite3_exec(database, "ALTER TABLE Graphs ADD canonical BLOB;", 0, 0, 0);
+	sqlite3_exec(database, "ALTER TABLE Graphs ADD testedMask INT NOT NULL DEFAULT 0;", 0, 0, 0);
+
+	if (sqlite3_exec(database, "ALTER TABLE Graphs ADD typeMask INT NOT NULL DEFAULT 0;", 0, 0, 0) == SQLITE_OK)
+	{
+		std::string mask = "0";
+		for (unsigned i = 0; i < types->size(); i++)
+			mask += " | CASE WHEN ',' || type || ',' LIKE '%," + std::string(types->at(i)) + ",%' THEN " + std::to_string(1u << i) + " ELSE 0 END";
+
+		statement = "UPDATE Graphs SET typeMask = " + mask + ", type = NULL WHERE type IS NOT NULL;";
+		execute_SQL_statement(&statement);
+	}
+
+	for (unsigned i = 0; i < types->size(); i++)
+		sqlite3_exec(database, ("ALTER TABLE Graphs ADD " + type_column(types->at(i)) + " INT AS ((typeMask >> " + std::to_string(i) + ") & 1);").c_str(), 0, 0, 0);
+
+	return true;
+}
+
+
+/**
+ * creates an index on the boolean column of each of given types
+**/
+void DatabaseInterface::create_type_indexes(std::vector<const char *> * types) {
+	for (unsigned i = 0; i < types->size(); i++)
+	{
+		std::string column = type_column(types->at(i));
+		std::string statement = "CREATE INDEX IF NOT EXISTS Graphs_" + column + " ON Graphs(" + column + ");";
+		execute_SQL_statement(&statement);
+	}
+}
+
+/**
+ * registers an SQL function for every type (named 'is_' followed by the name of its column, e.g., is_clawfree) and every value (named like its column, e.g., cliqueNr)
+ * each takes either the Graph6 of a graph or its graphOrder and graph (e.g., cliqueNr(graphOrder,COALESCE(g6,edges)) or is_chordal(g6)), so ad-hoc queries need no computed columns
+ * returns false if a function could not be registered
+**/
+bool DatabaseInterface::create_graph_functions(std::vector<bool (Graph::*)()> * graph_tests, std::vector<const char *> * types, std::vector<std::vector<unsigned>(Graph::*)()> * graph_values, std::vector<std::vector<const char *> *> * columns) {
+	std::shared_ptr<Function_cache> cache = std::make_shared<Function_cache>();
+	cache->values.resize(graph_values->size());
+	cache->computed.resize(graph_values->size(), false);
+
+	std::vector<std::pair<std::string, Graph_function>> functions;
+
+	for (unsigned i = 0; i < graph_tests->size(); i++)
+		functions.push_back(std::make_pair("is_" + type_column(types->at(i)), Graph_function{ cache, graph_tests->at(i), 0, 0, 0 }));
+
+	for (unsigned i = 0; i < graph_values->size(); i++)
+	{
+		for (unsigned j = 0; j < columns->at(i)->size(); j++)
+			functions.push_back(std::make_pair(std::string(columns->at(i)->at(j)), Graph_function{ cache, 0, graph_values->at(i), i, j }));
+	}
+
+	bool success = true;
+
+	for (unsigned i = 0; i < functions.size(); i++)
+	{
+		for (int arguments = 1; arguments <= 2; arguments++)
+		{
+			if (sqlite3_create_function_v2(database, functions[i].first.c_str(), arguments, SQLITE_UTF8 | SQLITE_DETERMINISTIC, new Graph_function(functions[i].second), &evaluate_graph_function, 0, 0, &delete_graph_function) != SQLITE_OK)
+			{
+				FAIL("Registering SQL functions", "Unable to register '" << functions[i].first << "'.");
+				success = false;
+			}
+		}
+	}
+
+	return success;
+}
+
+
+/**
+ * registers the g6file module, so a Graph6 file can be queried like a table without importing it (e.g., CREATE VIRTUAL TABLE g USING g6file('graphs.g6'))
+ * such a table offers the columns graphOrder, graphSize, edges and g6 as well as a column for every value and type, values and types are only computed for the columns a query reads
+ * returns false if the module could not be registered
+**/
+bool DatabaseInterface::create_g6file_module(std::vector<bool (Graph::*)()> * graph_tests, std::vector<const char *> * types, std::vector<std::vector<unsigned>(Graph::*)()> * graph_values, std::vector<std::vector<const char *> *> * columns) {
+	G6_file_module * module = new G6_file_module();
+	module->getters = *graph_values;
+	module->tests = *graph_tests;
+
+	for (unsigned i = 0; i < graph_values->size(); i++)
+		module->value_columns.push_back(std::vector<std::string>(columns->at(i)->begin(), columns->at(i)->end()));
+
+	for (unsigned i = 0; i < types->size(); i++)
+		module->type_columns.push_back(type_column(types->at(i)));
+
+	if (::create_g6file_module(database, module) != SQLITE_OK)
+	{
+		FAIL("Registering SQL functions", "Unable to register the module 'g6file'.");
+		return false;
+	}
+
+	return true;
+}
+
+
+
+/**
+ * expects graphs in given file to be formatted correctly
+ * imports the graphs into the database with a single prepared statement, storing each graph as a g6 BLOB and, unless compact is set, as a list of edges
+ * the import is committed every batch_size graphs (or once at the end if batch_size is 0), synchronous writes are turned off meanwhile
+ * the journal is only kept in memory for a single transaction, committed batches keep a journal file so that an interrupted import cannot corrupt the database
+ * if dedupe is set, the canonical Graph6 of every graph is stored as well and graphs isomorphic to one already in the database (or earlier in the file) are skipped
+ * returns the number of graphs read from file, or -1 if the import could not be started
+**/
+int DatabaseInterface::import_graphs(LineReader * file, bool (Graph::*Read_next_format)(LineReader * file), bool compact, unsigned batch_size, bool dedupe) {
+	std::string statement = dedupe
+		? "INSERT INTO Graphs (graphOrder,graphSize,edges,g6,canonical) SELECT ?1,?2,?3,?4,?5 WHERE NOT EXISTS (SELECT 1 FROM Graphs WHERE canonical == ?5)"
+		: "INSERT INTO Graphs (graphOrder,graphSize,edges,g6) VALUES (?,?,?,?)";
+
+	if (dedupe
+		&& !update_canonical_forms())
+	{
+		FAIL("Importing graphs", "");
+		return -1;
+	}
+
+	sqlite3_stmt * stmt;
+
+	if (sqlite3_prepare_v2(database, statement.c_str(), -1, &stmt, 0) != SQLITE_OK)
+	{
+		SQL_ERROR(statement);
+		FAIL("Importing graphs", "");
+		sqlite3_finalize(stmt);
+		return -1;
+	}
+
+	std::string synchronous = get_pragma("synchronous");
+	std::string journal_mode = get_pragma("journal_mode");
+	std::string cache_size = get_pragma("cache_size");
+
+	sqlite3_exec(database, "PRAGMA synchronous = OFF;", 0, 0, 0);
+	if (batch_size == 0)
+		sqlite3_exec(database, "PRAGMA journal_mode = MEMORY;", 0, 0, 0);
+	else if (journal_mode == "memory"
+		|| journal_mode == "off")
+		sqlite3_exec(database, "PRAGMA journal_mode = DELETE;", 0, 0, 0);
+	sqlite3_exec(database, "PRAGMA cache_size = " IMPORT_CACHE_SIZE ";", 0, 0, 0);
+
+	sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
+
+	unsigned j = 0;
+	unsigned duplicates = 0;
+	Graph g;
+	std::string edges;
+	std::string g6;
+	std::string canonical;
+
+	while ((g.*Read_next_format)(file))
+	{
+		g6 = g.convert_to_g6_format();
+
+		sqlite3_bind_int(stmt, 1, g.get_order());
+		sqlite3_bind_int(stmt, 2, g.get_size());
+		if (compact)
+			sqlite3_bind_null(stmt, 3);
+		else
+		{
+			edges = g.convert_to_string();
+			sqlite3_bind_text(stmt, 3, edges.c_str(), edges.length(), SQLITE_STATIC);
+		}
+		sqlite3_bind_blob(stmt, 4, g6.c_str(), g6.length(), SQLITE_STATIC);
+		if (dedupe)
+		{
+			canonical = g.convert_to_canonical_g6_format();
+			sqlite3_bind_blob(stmt, 5, canonical.c_str(), canonical.length(), SQLITE_STATIC);
+		}
+
+		if (sqlite3_step(stmt) != SQLITE_DONE)
+		{
+			FAIL("Importing graphs", sqlite3_errmsg(database) << (compact ? ". The Graphs table may require edges, i.e., predate compact imports." : "."));
+			sqlite3_reset(stmt);
+			break;
+		}
+
+		sqlite3_reset(stmt);
+		j++;
+
+		if (dedupe
+			&& sqlite3_changes(database) == 0)
+			duplicates++;
+
+		if (batch_size != 0
+			&& j % batch_size == 0)
+		{
+			sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+			PROGRESS(2, j - duplicates << " graphs imported");
+			sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
+		}
+	}
+
+	sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+	sqlite3_finalize(stmt);
+
+	sqlite3_exec(database, ("PRAGMA synchronous = " + synchronous + ";").c_str(), 0, 0, 0);
+	sqlite3_exec(database, ("PRAGMA journal_mode = " + journal_mode + ";").c_str(), 0, 0, 0);
+	sqlite3_exec(database, ("PRAGMA cache_size = " + cache_size + ";").c_str(), 0, 0, 0);
+
+	if (batch_size == 0
+		|| j % batch_size != 0)
+		PROGRESS(2, j - duplicates << " graphs imported");
 
-	if (sqlite3_exec(database, statement.c_str(), 0, 0, 0) != SQLITE_OK)
-		return false;
+	if (dedupe)
+		PROGRESS(2, duplicates << " isomorphic duplicates skipped");
 
-	return true;
+	return j;
 }
 
 
 /**
- * creates graphs table in the database
+ * stores the canonical Graph6 of every graph without one and indexes the canonical column, so isomorphic graphs can be found by their certificate
+ * graphs that cannot be decoded keep no canonical form, so they never match an imported graph
+ * returns false if the canonical forms could not be stored
 **/
-bool DatabaseInterface::create_graphs_table() {
-	std::string statement = "CREATE TABLE IF NOT EXISTS Graphs("  \
-							"graphID INTEGER PRIMARY KEY," \
-							"graphOrder INT NOT NULL," \
-							"graphSize INT NOT NULL," \
-							"edges TEXT NOT NULL," \
-							"type TEXT" \
-							");";
-
-	return execute_SQL_statement(&statement);
-}
+bool DatabaseInterface::update_canonical_forms() {
+	std::string query = "SELECT graphID,graphOrder," GRAPH_COLUMN " FROM Graphs NOT INDEXED WHERE canonical IS NULL";
+	std::string statement = "UPDATE Graphs SET canonical = ? WHERE graphID == ?";
 
+	sqlite3_stmt * qry;
+	sqlite3_stmt * stmt;
 
-/**
- * expects graphs in given file to be formatted correctly
- * batch imports the graphs into the database
-**/
-void DatabaseInterface::import_graphs(std::ifstream * file, bool (Graph::*Read_next_format)(std::ifstream * file)) {
-	sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
+	if (sqlite3_prepare_v2(database, query.c_str(), -1, &qry, 0) != SQLITE_OK)
+	{
+		SQL_ERROR(query);
+		sqlite3_finalize(qry);
+		return false;
+	}
 
-	unsigned j = 0;
-	while (true)
+	if (sqlite3_prepare_v2(database, statement.c_str(), -1, &stmt, 0) != SQLITE_OK)
 	{
-		unsigned i;
-		Graph g;
-		std::string statement = "INSERT INTO Graphs (graphOrder,graphSize,edges) VALUES ";
+		SQL_ERROR(statement);
+		sqlite3_finalize(qry);
+		sqlite3_finalize(stmt);
+		return false;
+	}
 
-		for (i = 0; i < 10 && (g.*Read_next_format)(file); i++)
-			statement += "(" + std::to_string(g.get_order()) + "," + std::to_string(g.get_size()) + ",'" + g.convert_to_string() + "'),";
+	sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
 
-		statement.pop_back();
+	unsigned updated = 0;
+	unsigned invalid = 0;
+	bool success = true;
+	Graph g;
+	bool g6;
+	std::string edges;
+	std::string canonical;
 
-		execute_SQL_statement(&statement);
+	while (sqlite3_step(qry) == SQLITE_ROW)
+	{
+		edges = read_graph_column(qry, 2, &g6);
+		if (!read_graph(&g, sqlite3_column_int(qry, 1), &edges, g6))
+		{
+			invalid++;
+			continue;
+		}
+		canonical = g.convert_to_canonical_g6_format();
 
-		j += i;
+		sqlite3_bind_blob(stmt, 1, canonical.c_str(), canonical.length(), SQLITE_STATIC);
+		sqlite3_bind_int(stmt, 2, sqlite3_column_int(qry, 0));
 
-		if (i < 10)
+		if (sqlite3_step(stmt) != SQLITE_DONE)
+		{
+			FAIL("Storing canonical forms", sqlite3_errmsg(database) << ".");
+			success = false;
 			break;
-	}
+		}
+		sqlite3_reset(stmt);
 
-	PROGRESS(2, j << " graphs imported");
+		if (++updated % 10000 == 0)
+			PROGRESS(2, 10000 << " canonical forms stored");
+	}
 
 	sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+	sqlite3_finalize(qry);
+	sqlite3_finalize(stmt);
+
+	if (updated % 10000 != 0)
+		PROGRESS(2, updated % 10000 << " canonical forms stored");
+
+	if (invalid != 0)
+		FAIL("Storing canonical forms", invalid << " graphs could not be decoded, their canonical forms were left NULL.");
+
+	return success
+		&& sqlite3_exec(database, "CREATE INDEX IF NOT EXISTS Graphs_canonical ON Graphs(canonical);", 0, 0, 0) == SQLITE_OK;
 }
 
 
 /**
- * updates the type of all graphs that satisfy graph_test and query_condition by quering the database and iterating over all results
+ * updates the types of all graphs that satisfy query_condition by evaluating all graph_tests in a single pass over the database
+ * a graph satisfying graph_tests[i] gets bit type_bits[i] of its typeMask set, a graph tested for it gets bit type_bits[i] of its testedMask set regardless of the outcome
+ * a graph is only tested for a type if it has been neither tested for nor classified as it and satisfies the respective type condition (if there is one)
+ * so a repeated classification only tests graphs imported since, not those that failed a test before
+ * progress is checkpointed in the row of jobID in the jobs table (if it is not -1), graphs up to its lastGraphID are skipped
+ * if jobID is -1 and command is given, a new job running command is registered once the queries are prepared
 **/
-bool DatabaseInterface::update_type(bool(Graph::*graph_test)(), const char * type, const char * query_condition) {
-	std::string query = "SELECT graphID,graphOrder,edges,type FROM Graphs WHERE (type IS NULL OR type NOT LIKE '%" + std::string(type) + "%')";
+bool DatabaseInterface::update_types(std::vector<bool (Graph::*)()> * graph_tests, std::vector<uint64_t (GraphBatch::*)()> * batch_tests, std::vector<unsigned> * type_bits, std::vector<const char *> * type_conditions, const char * query_condition, unsigned threads, int jobID, std::string * command) {
+	if (graph_tests->size() == 0)
+	{
+		FAIL("Classifying graphs", "No type specified.");
+		return false;
+	}
+
+	std::string flags = "";
+	std::string pending = "";
+
+	for (unsigned i = 0; i < graph_tests->size(); i++)
+	{
+		std::string flag = "((typeMask | testedMask) & " + std::to_string(1u << type_bits->at(i)) + ") == 0";
+		if (type_conditions->at(i))
+			flag += " AND (" + std::string(type_conditions->at(i)) + ")";
+
+		flags += ",(" + flag + ")";
+		pending += (i == 0 ? "(" : " OR (") + flag + ")";
+	}
+
+	std::string query = "SELECT graphID,graphOrder," GRAPH_COLUMN + flags + " FROM Graphs WHERE (" + pending + ")";
 	if (query_condition)
 		query += " AND (" + std::string(query_condition) + ")";
+	query += resume_condition(jobID) + " ORDER BY graphID";
 
 	sqlite3_stmt * qry;
 
 	if (sqlite3_prepare_v2(database, query.c_str(), -1, &qry, 0) != SQLITE_OK)
 	{
 		SQL_ERROR(query);
-		FAIL("Classifying type", "");
+		FAIL("Classifying graphs", "");
 		sqlite3_finalize(qry);
 		return false;
 	}
 
+	std::string statement = "UPDATE Graphs SET typeMask = typeMask | ?, testedMask = testedMask | ? WHERE graphID == ?";
+
 	sqlite3_stmt * stmt;
 
-	if (sqlite3_prepare_v2(database, "UPDATE Graphs SET type = ? WHERE graphID == ?", -1, &stmt, 0) != SQLITE_OK)
+	if (sqlite3_prepare_v2(database, statement.c_str(), -1, &stmt, 0) != SQLITE_OK)
 	{
-		SQL_ERROR("UPDATE Graphs SET type = ? WHERE graphID == ?");
-		FAIL("Classifying type", "");
+		SQL_ERROR(statement);
+		FAIL("Classifying graphs", "");
 		sqlite3_finalize(qry);
 		sqlite3_finalize(stmt);
 		return false;
 	}
 
-	sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
-	unsigned i;
-	for (i = 1; sqlite3_step(qry) == SQLITE_ROW; i++)
-	{
-		std::string edges = ((char *)sqlite3_column_text(qry, 2));
-		Graph g(sqlite3_column_int(qry, 1), &edges);
+	if (jobID == -1
+		&& command)
+		jobID = create_job(command);
 
-		if ((g.*graph_test)())
-		{
-			sqlite3_bind_text(stmt, 1, sqlite3_column_text(qry, 3) ? (std::string((char *)sqlite3_column_text(qry, 3)) + "," + std::string(type)).c_str() : type, -1, SQLITE_TRANSIENT);
-			sqlite3_bind_int(stmt, 2, sqlite3_column_int(qry, 0));
+	unsigned processed = process_graphs(qry, stmt, [graph_tests, batch_tests, type_bits](std::vector<Graph_row> * rows, std::vector<Graph_result> * results) {
+		Chunk_graphs chunk(rows);
+		std::vector<unsigned> satisfied(rows->size(), 0);
+		std::vector<unsigned> tested(rows->size(), 0);
 
-			sqlite3_step(stmt);
+		for (unsigned i = 0; i < graph_tests->size(); i++)
+		{
+			unsigned bit = 1u << type_bits->at(i);
+			std::vector<bool> batched(rows->size(), false);
+			std::vector<bool> passed(rows->size(), false);
+
+			if (batch_tests->at(i))
+				visit_batches(&chunk, i, &batched, [&passed, batch_tests, i](GraphBatch * batch, std::vector<unsigned> * indices) {
+					uint64_t mask = (batch->*(batch_tests->at(i)))();
+					for (unsigned k = 0; k < indices->size(); k++)
+						passed[indices->at(k)] = (mask >> k) & 1;
+				});
+
+			for (unsigned j = 0; j < rows->size(); j++)
+			{
+				if (((rows->at(j).flags >> i) & 1) == 0
+					|| !chunk.is_valid(j))
+					continue;
 
-			sqlite3_clear_bindings(stmt);
-			sqlite3_reset(stmt);
+				tested[j] |= bit;
+				if (batched[j] ? passed[j] : (chunk.get(j)->*(graph_tests->at(i)))())
+					satisfied[j] |= bit;
+			}
 		}
 
-		if (i == 10000)
+		for (unsigned j = 0; j < rows->size(); j++)
 		{
-			PROGRESS(2, i << " graphs tested");
-			i = 1;
+			results->at(j).values = { satisfied[j], tested[j] };
+			results->at(j).update = tested[j] != 0;
+			results->at(j).invalid = !chunk.is_valid(j);
 		}
-	}
-	sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+	}, 2, threads, "graphs tested", jobID);
 
 	sqlite3_finalize(qry);
 	sqlite3_finalize(stmt);
 
-	if (i > 1)
-		PROGRESS(2, i - 1 << " graphs tested");
-	else
+	if (processed == 0)
 	{
-		FAIL("Classifying type", "Unable to find any graphs satisfying the condition of the query: '" << query << "'.");
+		FAIL("Classifying graphs", "Unable to find any graphs not yet tested that satisfy the condition of the query: '" << query << "'.");
 		return false;
 	}
 
@@ -826,25 +2096,45 @@ bool DatabaseInterface::update_type(bool(Graph::*graph_test)(), const char * typ
 
 
 /**
-* updates with graph_values the values in given columns of all graphs that satisfy query_condition by quering the database and iterating over all results
+* updates with graph_values the values in the respective columns of all graphs that satisfy query_condition in a single pass over the database
+* a value set is only computed for a graph if all of its columns are NULL
+* progress is checkpointed in the row of jobID in the jobs table (if it is not -1), graphs up to its lastGraphID are skipped
+* if jobID is -1 and command is given, a new job running command is registered once the queries are prepared
 **/
-bool DatabaseInterface::update_values(std::vector<unsigned>(Graph::*graph_values)(), std::vector<const char *> * columns, const char * query_condition) {
-	if (columns->size() == 0)
+bool DatabaseInterface::update_values(std::vector<std::vector<unsigned>(Graph::*)()> * graph_values, std::vector<std::vector<std::vector<unsigned>>(GraphBatch::*)()> * batch_values, std::vector<std::vector<const char *> *> * columns, const char * query_condition, unsigned threads, int jobID, std::string * command) {
+	if (graph_values->size() == 0)
 	{
 		FAIL("Computing values", "No value set specified.");
 		return false;
 	}
 
+	std::string flags = "";
+	std::string pending = "";
+	std::string assignments = "";
+	unsigned number_values = 0;
+
 	for (unsigned i = 0; i < columns->size(); i++)
-		sqlite3_exec(database, (std::string("ALTER TABLE Graphs ADD ") + columns->at(i) + " INT;").c_str(), 0, 0, 0);
+	{
+		std::string flag = "";
+
+		for (unsigned j = 0; j < columns->at(i)->size(); j++)
+		{
+			std::string column = columns->at(i)->at(j);
+			sqlite3_exec(database, ("ALTER TABLE Graphs ADD " + column + " INT;").c_str(), 0, 0, 0);
+
+			flag += (j == 0 ? "" : " AND ") + column + " IS NULL";
+			assignments += (number_values == 0 ? " " : ", ") + column + " = COALESCE(?, " + column + ")";
+			number_values++;
+		}
 
-	std::string query = "SELECT graphID,graphOrder,edges FROM Graphs WHERE (" + std::string(columns->at(0)) + " IS NULL";
-	for (unsigned i = 1; i < columns->size(); i++)
-		query += " AND " + std::string(columns->at(i)) + " IS NULL";
-	query += ")";
+		flags += ",(" + flag + ")";
+		pending += (i == 0 ? "(" : " OR (") + flag + ")";
+	}
 
+	std::string query = "SELECT graphID,graphOrder," GRAPH_COLUMN + flags + " FROM Graphs WHERE (" + pending + ")";
 	if (query_condition)
 		query += " AND (" + std::string(query_condition) + ")";
+	query += resume_condition(jobID) + " ORDER BY graphID";
 
 	sqlite3_stmt * qry;
 
@@ -856,10 +2146,7 @@ bool DatabaseInterface::update_values(std::vector<unsigned>(Graph::*graph_values
 		return false;
 	}
 
-	std::string statement = "UPDATE Graphs SET " + std::string(columns->at(0)) + " = ?";
-	for (unsigned i = 1; i < columns->size(); i++)
-		statement += ", " + std::string(columns->at(i)) + " = ?";
-	statement += " WHERE graphID == ?";
+	std::string statement = "UPDATE Graphs SET" + assignments + " WHERE graphID == ?";
 
 	sqlite3_stmt * stmt;
 
@@ -872,48 +2159,53 @@ bool DatabaseInterface::update_values(std::vector<unsigned>(Graph::*graph_values
 		return false;
 	}
 
-	sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
-	unsigned i;
-	for (i = 1; sqlite3_step(qry) == SQLITE_ROW; i++)
-	{
-		std::string edges = ((char *)sqlite3_column_text(qry, 2));
-		Graph g(sqlite3_column_int(qry, 1), &edges);
+	if (jobID == -1
+		&& command)
+		jobID = create_job(command);
 
-		std::vector<unsigned> values = (g.*graph_values)();
+	unsigned processed = process_graphs(qry, stmt, [graph_values, batch_values, columns](std::vector<Graph_row> * rows, std::vector<Graph_result> * results) {
+		Chunk_graphs chunk(rows);
 
-		if (values.size() != columns->size())
+		for (unsigned i = 0; i < graph_values->size(); i++)
 		{
-			FAIL("Computing values", "There are not the same amounts of values and columns.");
-			sqlite3_exec(database, "COMMIT;", 0, 0, 0);
-			sqlite3_finalize(qry);
-			sqlite3_finalize(stmt);
-			return false;
-		}
-
-		for (unsigned j = 0; j < values.size(); j++)
-			sqlite3_bind_int(stmt, j + 1, values[j]);
+			std::vector<std::vector<unsigned>> set_values(rows->size());
+			std::vector<bool> batched(rows->size(), false);
 
-		sqlite3_bind_int(stmt, values.size() + 1, sqlite3_column_int(qry, 0));
+			if (batch_values->at(i))
+				visit_batches(&chunk, i, &batched, [&set_values, batch_values, i](GraphBatch * batch, std::vector<unsigned> * indices) {
+					std::vector<std::vector<unsigned>> batch_set_values = (batch->*(batch_values->at(i)))();
+					for (unsigned k = 0; k < indices->size(); k++)
+						set_values[indices->at(k)] = std::move(batch_set_values[k]);
+				});
 
-		sqlite3_step(stmt);
+			for (unsigned j = 0; j < rows->size(); j++)
+			{
+				std::vector<unsigned> * values = &results->at(j).values;
 
-		sqlite3_clear_bindings(stmt);
-		sqlite3_reset(stmt);
+				if (((rows->at(j).flags >> i) & 1) == 0
+					|| !chunk.is_valid(j))
+					values->insert(values->end(), columns->at(i)->size(), NULL_VALUE);
+				else if (batched[j])
+					values->insert(values->end(), set_values[j].begin(), set_values[j].end());
+				else
+				{
+					std::vector<unsigned> graph_set_values = (chunk.get(j)->*(graph_values->at(i)))();
+					values->insert(values->end(), graph_set_values.begin(), graph_set_values.end());
+				}
+			}
+		}
 
-		if (i == 10000)
+		for (unsigned j = 0; j < rows->size(); j++)
 		{
-			PROGRESS(2, i << " graphs updated");
-			i = 1;
+			results->at(j).update = true;
+			results->at(j).invalid = !chunk.is_valid(j);
 		}
-	}
-	sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+	}, number_values, threads, "graphs updated", jobID);
 
 	sqlite3_finalize(qry);
 	sqlite3_finalize(stmt);
 
-	if (i > 1)
-		PROGRESS(2, i - 1 << " graphs updated");
-	else
+	if (processed == 0)
 	{
 		FAIL("Computing values", "Unable to find any graphs satisfying the condition of the query: '" << query << "'.");
 		return false;
@@ -925,13 +2217,13 @@ bool DatabaseInterface::update_values(std::vector<unsigned>(Graph::*graph_values
 
 /**
 * returns the internal result type of the script with ID scriptID in the scripts table
-* changes the values of name, query_condition and datetime to the respective values in the scripts table
+* changes the values of name, query_condition, datetime and batches to the respective values in the scripts table (batches is 0 for scripts generated without recording it)
 **/
-unsigned DatabaseInterface::find_script_data(unsigned scriptID, std::string * name, std::string * query_condition, std::string * datetime) {
+unsigned DatabaseInterface::find_script_data(unsigned scriptID, std::string * name, std::string * query_condition, std::string * datetime, unsigned * batches) {
 	sqlite3_stmt * qry1;
-	if (sqlite3_prepare_v2(database, ("SELECT name,condition,datetime,resultType FROM Scripts WHERE scriptID == " + std::to_string(scriptID)).c_str(), -1, &qry1, 0) != SQLITE_OK)
+	if (sqlite3_prepare_v2(database, ("SELECT name,condition,datetime,resultType,batches FROM Scripts WHERE scriptID == " + std::to_string(scriptID)).c_str(), -1, &qry1, 0) != SQLITE_OK)
 	{
-		SQL_ERROR("SELECT name,condition,datetime,resultType FROM Scripts WHERE scriptID == " << scriptID);
+		SQL_ERROR("SELECT name,condition,datetime,resultType,batches FROM Scripts WHERE scriptID == " << scriptID);
 		FAIL("Adding Betti data", "");
 		sqlite3_finalize(qry1);
 		return -1;
@@ -948,6 +2240,7 @@ unsigned DatabaseInterface::find_script_data(unsigned scriptID, std::string * na
 	*query_condition = (char *)sqlite3_column_text(qry1, 1) ? (char *)sqlite3_column_text(qry1, 1) : "";
 	*datetime = (char *)sqlite3_column_text(qry1, 2);
 	unsigned index = sqlite3_column_int(qry1, 3);
+	*batches = sqlite3_column_int(qry1, 4);
 	sqlite3_finalize(qry1);
 
 	return index;
@@ -955,9 +2248,11 @@ unsigned DatabaseInterface::find_script_data(unsigned scriptID, std::string * na
 
 
 /**
- * reads all Betti tables from the files determined by the given name, datetime and index, updates all graphs satisfying query_condition
+ * reads all Betti tables from the files determined by the given name, datetime and index (batches files if batches is nonzero, only the file of given batch unless it is -1), updates the graph with the graphID in front of each table
+ * tables without graphIDs (from older scripts) update the graphs satisfying query_condition in order
+ * returns false if a file is missing, the results of all other files are added anyway
 **/
-bool DatabaseInterface::insert_betti_data(std::string * name, std::string * query_condition, std::string * datetime, unsigned index) {
+bool DatabaseInterface::insert_betti_data(std::string * name, std::string * query_condition, std::string * datetime, unsigned index, unsigned batches, int batch) {
 	std::string column_name = *name;
 	size_t cut_index = column_name.find_first_of(' ');
 	while (cut_index < column_name.length() - 1)
@@ -1004,13 +2299,29 @@ bool DatabaseInterface::insert_betti_data(std::string * name, std::string * quer
 
 	sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
 	unsigned count = 0;
-	for (unsigned k = 0; true; k++)
+	unsigned missing = 0;
+	unsigned unmatched = 0;
+	for (unsigned k = batch == -1 ? 0 : batch; batches == 0 || k < batches; k++)
 	{
 		std::string filename = std::to_string(index) + "_" + *datetime + "_" + *name + "_" + std::to_string(k) + ".result";
 		std::ifstream kFile(filename);
 
 		if (!kFile.is_open())
 		{
+			if (batch != -1)
+			{
+				FAIL("Adding Betti data", "Unable to open '" << filename << "'.");
+				sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+				sqlite3_finalize(qry2);
+				sqlite3_finalize(stmt1);
+				return false;
+			}
+			if (batches != 0)
+			{
+				PROGRESS(2, "'" << filename << "' is missing");
+				missing++;
+				continue;
+			}
 			if (k == 0)
 			{
 				FAIL("Adding Betti data", "Unable to open '" << filename << "'.");
@@ -1023,27 +2334,48 @@ bool DatabaseInterface::insert_betti_data(std::string * name, std::string * quer
 		}
 
 		BettiTable b;
+		int graphID;
+		bool keyed = read_result_graphID(&kFile, &graphID);
 
 		while (b.read_next_table(&kFile))
 		{
-			if (sqlite3_step(qry2) != SQLITE_ROW)
+			if (!keyed)
 			{
-				FAIL("Adding Betti data", "There are more tables in the files than graphs satisfying condition '" << *query_condition << "' in the database.");
-				kFile.close();
-				sqlite3_exec(database, "COMMIT;", 0, 0, 0);
-				sqlite3_finalize(qry2);
-				sqlite3_finalize(stmt1);
-				return false;
+				if (missing != 0
+					|| batch > 0)
+				{
+					FAIL("Adding Betti data", "The tables in '" << filename << "' have no graphIDs, so they cannot be matched to graphs without reading all earlier result files.");
+					kFile.close();
+					sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+					sqlite3_finalize(qry2);
+					sqlite3_finalize(stmt1);
+					return false;
+				}
+
+				if (sqlite3_step(qry2) != SQLITE_ROW)
+				{
+					FAIL("Adding Betti data", "There are more tables in the files than graphs satisfying condition '" << *query_condition << "' in the database.");
+					kFile.close();
+					sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+					sqlite3_finalize(qry2);
+					sqlite3_finalize(stmt1);
+					return false;
+				}
+
+				graphID = sqlite3_column_int(qry2, 0);
 			}
 
 			sqlite3_bind_text(stmt1, 1, b.convert_to_line().c_str(), -1, SQLITE_TRANSIENT);
 			sqlite3_bind_int(stmt1, 2, b.get_projective_dimension());
 			sqlite3_bind_int(stmt1, 3, b.get_regularity());
 			sqlite3_bind_text(stmt1, 4, b.get_extremal_betti_numbers_as_string().c_str(), -1, SQLITE_TRANSIENT);
-			sqlite3_bind_int(stmt1, 5, sqlite3_column_int(qry2, 0));
+			sqlite3_bind_int(stmt1, 5, graphID);
 
 			sqlite3_step(stmt1);
 
+			if (sqlite3_changes(database) == 0)
+				unmatched++;
+
 			sqlite3_clear_bindings(stmt1);
 			sqlite3_reset(stmt1);
 
@@ -1054,26 +2386,42 @@ bool DatabaseInterface::insert_betti_data(std::string * name, std::string * quer
 				PROGRESS(2, count << " graphs updated");
 				count = 0;
 			}
+
+			keyed = read_result_graphID(&kFile, &graphID);
 		}
 
 		kFile.close();
+
+		if (batch != -1)
+			break;
 	}
 
 	if (count != 0)
 		PROGRESS(2, count << " graphs updated");
+
+	if (unmatched != 0)
+		PROGRESS(2, unmatched << " tables did not match any graph in the database");
 	
 	sqlite3_exec(database, "COMMIT;", 0, 0, 0);
 	sqlite3_finalize(qry2);
 	sqlite3_finalize(stmt1);
 
+	if (missing != 0)
+	{
+		FAIL("Adding Betti data", missing << " of " << batches << " result files are missing. The script is kept so that their results can be added later.");
+		return false;
+	}
+
 	return true;
 }
 
 
 /**
-* reads all degrees of h-polynomials from the files determined by the given name, datetime and index, updates all graphs satisfying query_condition
+* reads all degrees of h-polynomials from the files determined by the given name, datetime and index (batches files if batches is nonzero, only the file of given batch unless it is -1), updates the graph with the graphID in front of each degree
+* degrees without graphIDs (from older scripts) update the graphs satisfying query_condition in order
+* returns false if a file is missing, the degrees of all other files are added anyway
 **/
-bool DatabaseInterface::insert_hpoldeg_data(std::string * name, std::string * query_condition, std::string * datetime, unsigned index) {
+bool DatabaseInterface::insert_hpoldeg_data(std::string * name, std::string * query_condition, std::string * datetime, unsigned index, unsigned batches, int batch) {
 	sqlite3_exec(database, (std::string("ALTER TABLE Graphs ADD ") + *name + "Hpoldeg INT;").c_str(), 0, 0, 0);
 
 	sqlite3_stmt * qry2;
@@ -1112,13 +2460,29 @@ bool DatabaseInterface::insert_hpoldeg_data(std::string * name, std::string * qu
 
 	sqlite3_exec(database, "BEGIN TRANSACTION;", 0, 0, 0);
 	unsigned count = 0;
-	for (unsigned k = 0; true; k++)
+	unsigned missing = 0;
+	unsigned unmatched = 0;
+	for (unsigned k = batch == -1 ? 0 : batch; batches == 0 || k < batches; k++)
 	{
 		std::string filename = std::to_string(index) + "_" + *datetime + "_" + *name + "_" + std::to_string(k) + ".result";
 		std::ifstream kFile(filename);
 
 		if (!kFile.is_open())
 		{
+			if (batch != -1)
+			{
+				FAIL("Adding hpoldeg data", "Unable to open '" << filename << "'.");
+				sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+				sqlite3_finalize(qry2);
+				sqlite3_finalize(stmt1);
+				return false;
+			}
+			if (batches != 0)
+			{
+				PROGRESS(2, "'" << filename << "' is missing");
+				missing++;
+				continue;
+			}
 			if (k == 0)
 			{
 				FAIL("Adding hpoldeg data", "Unable to open '" << filename << "'.");
@@ -1131,6 +2495,8 @@ bool DatabaseInterface::insert_hpoldeg_data(std::string * name, std::string * qu
 		}
 
 		std::string line;
+		int graphID;
+		bool keyed = read_result_graphID(&kFile, &graphID);
 
 		while (getline(kFile, line))
 		{
@@ -1160,21 +2526,40 @@ bool DatabaseInterface::insert_hpoldeg_data(std::string * name, std::string * qu
 			if (line.at(0) == '-')
 				hpoldeg *= -1;
 
-			if (sqlite3_step(qry2) != SQLITE_ROW)
+			if (!keyed)
 			{
-				FAIL("Adding hpoldeg data", "There are more numbers in the files than graphs satisfying condition '" << *query_condition << "' in the database.");
-				kFile.close();
-				sqlite3_exec(database, "COMMIT;", 0, 0, 0);
-				sqlite3_finalize(qry2);
-				sqlite3_finalize(stmt1);
-				return false;
+				if (missing != 0
+					|| batch > 0)
+				{
+					FAIL("Adding hpoldeg data", "The numbers in '" << filename << "' have no graphIDs, so they cannot be matched to graphs without reading all earlier result files.");
+					kFile.close();
+					sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+					sqlite3_finalize(qry2);
+					sqlite3_finalize(stmt1);
+					return false;
+				}
+
+				if (sqlite3_step(qry2) != SQLITE_ROW)
+				{
+					FAIL("Adding hpoldeg data", "There are more numbers in the files than graphs satisfying condition '" << *query_condition << "' in the database.");
+					kFile.close();
+					sqlite3_exec(database, "COMMIT;", 0, 0, 0);
+					sqlite3_finalize(qry2);
+					sqlite3_finalize(stmt1);
+					return false;
+				}
+
+				graphID = sqlite3_column_int(qry2, 0);
 			}
 
 			sqlite3_bind_int(stmt1, 1, hpoldeg);
-			sqlite3_bind_int(stmt1, 2, sqlite3_column_int(qry2, 0));
+			sqlite3_bind_int(stmt1, 2, graphID);
 
 			sqlite3_step(stmt1);
 
+			if (sqlite3_changes(database) == 0)
+				unmatched++;
+
 			sqlite3_clear_bindings(stmt1);
 			sqlite3_reset(stmt1);
 
@@ -1185,17 +2570,189 @@ bool DatabaseInterface::insert_hpoldeg_data(std::string * name, std::string * qu
 				PROGRESS(2, count << " graphs updated");
 				count = 0;
 			}
+
+			keyed = read_result_graphID(&kFile, &graphID);
 		}
 
 		kFile.close();
+
+		if (batch != -1)
+			break;
 	}
 
 	if (count != 0)
 		PROGRESS(2, count << " graphs updated");
 
+	if (unmatched != 0)
+		PROGRESS(2, unmatched << " numbers did not match any graph in the database");
+
 	sqlite3_exec(database, "COMMIT;", 0, 0, 0);
 	sqlite3_finalize(qry2);
 	sqlite3_finalize(stmt1);
 
+	if (missing != 0)
+	{
+		FAIL("Adding hpoldeg data", missing << " of " << batches << " result files are missing. The script is kept so that their results can be added later.");
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+* runs the Macaulay2 scripts of the script with ID scriptID by command (e.g., 'M2 --script') in up to processes parallel child processes
+* insert_batch is called on the result file of every batch as soon as its script has finished, batches failing (or whose results cannot be added) are run up to retries more times
+* status, attempts and runtime of every batch are kept in the batches table, batches already done by an earlier run are skipped
+* returns true if all batches of the script are done
+**/
+bool DatabaseInterface::run_m2_scripts(unsigned scriptID, std::string * name, std::string * datetime, unsigned index, unsigned batches, const char * command, unsigned processes, unsigned retries, std::function<bool(unsigned batch)> insert_batch) {
+	if (batches == 0)
+	{
+		FAIL("Running M2 scripts", "The number of batches of script " << scriptID << " is unknown, its scripts were generated by an older version.");
+		return false;
+	}
+
+	std::vector<std::string> status(batches, "pending");
+	std::vector<unsigned> attempts(batches, 0);
+	std::vector<unsigned> tries(batches, 0);
+
+	sqlite3_stmt * qry;
+	if (sqlite3_prepare_v2(database, ("SELECT batch,status,attempts FROM Batches WHERE scriptID == " + std::to_string(scriptID)).c_str(), -1, &qry, 0) != SQLITE_OK)
+	{
+		SQL_ERROR("SELECT batch,status,attempts FROM Batches WHERE scriptID == " << scriptID);
+		FAIL("Running M2 scripts", "");
+		sqlite3_finalize(qry);
+		return false;
+	}
+
+	while (sqlite3_step(qry) == SQLITE_ROW)
+	{
+		unsigned batch = sqlite3_column_int(qry, 0);
+		if (batch < batches)
+		{
+			status[batch] = (char *)sqlite3_column_text(qry, 1);
+			attempts[batch] = sqlite3_column_int(qry, 2);
+		}
+	}
+	sqlite3_finalize(qry);
+
+	sqlite3_stmt * stmt;
+	if (sqlite3_prepare_v2(database, "INSERT OR REPLACE INTO Batches (scriptID,batch,status,attempts,runtime) VALUES (?,?,?,?,?)", -1, &stmt, 0) != SQLITE_OK)
+	{
+		SQL_ERROR("INSERT OR REPLACE INTO Batches (scriptID,batch,status,attempts,runtime) VALUES (?,?,?,?,?)");
+		FAIL("Running M2 scripts", "");
+		sqlite3_finalize(stmt);
+		return false;
+	}
+
+	auto write_status = [this, stmt, scriptID, &status, &attempts](unsigned batch, const char * new_status, double runtime) {
+		status[batch] = new_status;
+
+		sqlite3_bind_int(stmt, 1, scriptID);
+		sqlite3_bind_int(stmt, 2, batch);
+		sqlite3_bind_text(stmt, 3, new_status, -1, SQLITE_STATIC);
+		sqlite3_bind_int(stmt, 4, attempts[batch]);
+		if (runtime < 0)
+			sqlite3_bind_null(stmt, 5);
+		else
+			sqlite3_bind_double(stmt, 5, runtime);
+
+		sqlite3_step(stmt);
+		sqlite3_reset(stmt);
+	};
+
+	std::string prefix = std::to_string(index) + "_" + *datetime + "_" + *name + "_";
+
+	WorkQueue<unsigned> jobs(batches);
+	WorkQueue<Batch_event> events(2 * batches);
+	unsigned outstanding = 0;
+
+	for (unsigned k = 0; k < batches; k++)
+	{
+		if (status[k] == "done")
+			continue;
+
+		jobs.push(std::move(k));
+		outstanding++;
+	}
+
+	if (outstanding == 0)
+		jobs.close();
+
+	if (processes > outstanding)
+		processes = outstanding;
+
+	PROGRESS(2, "running " << outstanding << " of " << batches << " scripts in " << processes << " processes");
+
+	std::vector<std::thread> workers;
+	for (unsigned t = 0; t < processes; t++)
+		workers.push_back(std::thread([&jobs, &events, &prefix, command] {
+			unsigned batch;
+			while (jobs.pop(&batch))
+			{
+				std::string result = prefix + std::to_string(batch) + ".result";
+				std::remove(result.c_str());
+
+				if (!events.push(Batch_event{ batch, true, false, 0 }))
+					break;
+
+				auto start = std::chrono::steady_clock::now();
+				int exit_status = std::system((std::string(command) + " " + prefix + std::to_string(batch) + ".m2").c_str());
+				double runtime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+				if (!events.push(Batch_event{ batch, false, exit_status == 0 && std::ifstream(result).good(), runtime }))
+					break;
+			}
+		}));
+
+	unsigned failed = 0;
+	Batch_event event;
+	while (outstanding > 0
+		&& events.pop(&event))
+	{
+		if (event.started)
+		{
+			attempts[event.batch]++;
+			tries[event.batch]++;
+			write_status(event.batch, "running", -1);
+			continue;
+		}
+
+		if (event.success
+			&& insert_batch(event.batch))
+		{
+			write_status(event.batch, "done", event.runtime);
+			PROGRESS(2, "batch " << event.batch << " done in " << event.runtime << "s");
+		}
+		else if (tries[event.batch] <= retries)
+		{
+			write_status(event.batch, "failed", event.runtime);
+			PROGRESS(2, "batch " << event.batch << " failed, retrying");
+			jobs.push(std::move(event.batch));
+			continue;
+		}
+		else
+		{
+			write_status(event.batch, "failed", event.runtime);
+			PROGRESS(2, "batch " << event.batch << " failed");
+			failed++;
+		}
+
+		if (--outstanding == 0)
+			jobs.close();
+	}
+
+	for (unsigned t = 0; t < workers.size(); t++)
+		workers[t].join();
+
+	sqlite3_finalize(stmt);
+
+	if (failed != 0)
+	{
+		FAIL("Running M2 scripts", failed << " of " << batches << " batches failed. The script is kept so that they can be run again.");
+		return false;
+	}
+
 	return true;
 }
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "stdafx.h"
+#include "Graph.h"
+
+
+#define FIXED_MAX_ORDER 16
+
+
+/**
+* kernels of Graph compiled for graphs of fixed order N (at least 1), working on the adjacency rows of a Graph (bit w of row v is set iff the vertex indices v and w are adjacent)
+* all loops run to the constant N and all scratch arrays live on the stack, so small graphs avoid the heap allocations and runtime bounds of the general member functions
+* the results equal those of the respective member functions of Graph, which dispatch to Fixed_kernels::get(order) for orders up to FIXED_MAX_ORDER
+**/
+template<unsigned N>
+class FixedGraph
+{
+private:
+	static const uint64_t ALL = N == 64 ? ~(uint64_t)0 : ((uint64_t)1 << N) - 1;
+
+	/**
+	 * changes ordering (vertex indices in the order they are visited) and ordering_indices (position of every vertex index) to a lexicographic-breadth-first-search via partition refinement
+	 * ties are broken in favour of the vertex appearing last in the ordering given by previous_indices (LexBFS+), or of the highest vertex if it is 0
+	**/
+	static void lexicographic_ordering(const uint64_t * adjacencies, const unsigned * previous_indices, unsigned * ordering, unsigned * ordering_indices) {
+		uint64_t partitions[N];
+		uint64_t refined[N];
+		unsigned number_partitions = 1;
+		partitions[0] = ALL;
+
+		for (unsigned i = 0; i < N; i++)
+		{
+			uint64_t * last = &partitions[number_partitions - 1];
+			unsigned v = highest_set_bit(*last);
+
+			if (previous_indices)
+			{
+				for (uint64_t rest = *last; rest; rest &= rest - 1)
+				{
+					unsigned w = lowest_set_bit(rest);
+					if (previous_indices[w] > previous_indices[v])
+						v = w;
+				}
+			}
+
+			*last &= ~((uint64_t)1 << v);
+			if (*last == 0)
+				number_partitions--;
+
+			ordering[i] = v;
+			ordering_indices[v] = i;
+
+			unsigned number_refined = 0;
+			for (unsigned p = 0; p < number_partitions; p++)
+			{
+				uint64_t intersection = partitions[p] & adjacencies[v];
+				uint64_t difference = partitions[p] & ~adjacencies[v];
+
+				if (difference)
+					refined[number_refined++] = difference;
+				if (intersection)
+					refined[number_refined++] = intersection;
+			}
+
+			for (unsigned p = 0; p < number_refined; p++)
+				partitions[p] = refined[p];
+			number_partitions = number_refined;
+		}
+	}
+
+public:
+	/**
+	 * returns the length of a shortest cycle, or 0 if there is none, by a breadth-first search from every vertex of degree at least 2
+	 * every edge closing a cycle in a search gives an upper bound, the minimum over all searches is the girth
+	**/
+	static unsigned get_girth(const uint64_t * adjacencies) {
+		unsigned girth = N + 1;
+		unsigned parent[N];
+		unsigned distance[N];
+		unsigned queue[N];
+
+		for (unsigned v = 0; v < N; v++)
+		{
+			if (count_set_bits(adjacencies[v]) < 2)
+				continue;
+
+			uint64_t discovered = (uint64_t)1 << v;
+			unsigned length = 1;
+			queue[0] = v;
+			parent[v] = v;
+			distance[v] = 0;
+
+			for (unsigned front = 0; front < length && 2 * distance[queue[front]] + 1 < girth; front++)
+			{
+				unsigned current = queue[front];
+
+				for (uint64_t rest = adjacencies[current] & ~((uint64_t)1 << parent[current]); rest; rest &= rest - 1)
+				{
+					unsigned neighbour = lowest_set_bit(rest);
+
+					if (!(discovered & ((uint64_t)1 << neighbour)))
+					{
+						discovered |= (uint64_t)1 << neighbour;
+						parent[neighbour] = current;
+						distance[neighbour] = distance[current] + 1;
+						queue[length++] = neighbour;
+					}
+					else if (girth > distance[neighbour] + distance[current] + 1)
+						girth = distance[neighbour] + distance[current] + 1;
+				}
+			}
+		}
+
+		return girth == N + 1 ? 0 : girth;
+	}
+
+
+	/**
+	 * tests if the graph is chordal by checking that the reverse of a lexicographic-breadth-first-search is a perfect elimination ordering
+	**/
+	static bool is_chordal(const uint64_t * adjacencies) {
+		if (N < 4)
+			return true;
+
+		unsigned ordering[N];
+		unsigned ordering_indices[N];
+		lexicographic_ordering(adjacencies, 0, ordering, ordering_indices);
+
+		for (unsigned v = 0; v < N; v++)
+		{
+			// neighbours visited before v by the search, as a mask of positions in the ordering
+			uint64_t prior = 0;
+			for (uint64_t rest = adjacencies[v]; rest; rest &= rest - 1)
+			{
+				unsigned index = ordering_indices[lowest_set_bit(rest)];
+				if (index < ordering_indices[v])
+					prior |= (uint64_t)1 << index;
+			}
+
+			if (prior == 0)
+				continue;
+
+			unsigned parent_index = highest_set_bit(prior);
+			unsigned parent = ordering[parent_index];
+			for (uint64_t rest = prior & ~((uint64_t)1 << parent_index); rest; rest &= rest - 1)
+			{
+				if (!((adjacencies[parent] >> ordering[lowest_set_bit(rest)]) & 1))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+
+	/**
+	 * changes ordering to a candidate for a proper interval ordering via three sweeps of LexBFS+ (Corneil)
+	 * returns true if it is a proper interval ordering, i.e., the closed neighbourhood of every vertex is consecutive in the ordering
+	**/
+	static bool gen_proper_interval_ordering(const uint64_t * adjacencies, unsigned * ordering) {
+		unsigned sweep_indices[N];
+		unsigned previous_indices[N];
+
+		lexicographic_ordering(adjacencies, 0, ordering, sweep_indices);
+		for (unsigned sweep = 2; sweep <= 3; sweep++)
+		{
+			for (unsigned i = 0; i < N; i++)
+				previous_indices[i] = sweep_indices[i];
+			lexicographic_ordering(adjacencies, previous_indices, ordering, sweep_indices);
+		}
+
+		for (unsigned i = 0; i < N; i++)
+		{
+			uint64_t neighbourhood = (uint64_t)1 << i;
+			for (uint64_t rest = adjacencies[ordering[i]]; rest; rest &= rest - 1)
+				neighbourhood |= (uint64_t)1 << sweep_indices[lowest_set_bit(rest)];
+
+			if (((neighbourhood + (neighbourhood & (~neighbourhood + 1))) & neighbourhood) != 0)
+				return false;
+		}
+
+		return true;
+	}
+
+
+	/**
+	 * tests if the graph is closed, i.e., a proper interval graph
+	**/
+	static bool is_closed(const uint64_t * adjacencies) {
+		if (N < 3)
+			return true;
+
+		unsigned ordering[N];
+		return gen_proper_interval_ordering(adjacencies, ordering);
+	}
+};
+
+
+/**
+* kernels of FixedGraph<order> for a given order
+**/
+struct Fixed_kernels
+{
+	unsigned (*get_girth)(const uint64_t * adjacencies);
+	bool (*is_chordal)(const uint64_t * adjacencies);
+	bool (*gen_proper_interval_ordering)(const uint64_t * adjacencies, unsigned * ordering);
+	bool (*is_closed)(const uint64_t * adjacencies);
+
+	/**
+	 * returns the kernels for graphs of given order, which has to be between 1 and FIXED_MAX_ORDER
+	**/
+	static const Fixed_kernels & get(unsigned order);
+};
+
+
+/**
+* fills the dispatch table of Fixed_kernels with the specializations for orders 1 to N
+**/
+template<unsigned N>
+struct Fixed_table
+{
+	static void fill(Fixed_kernels * table) {
+		table[N] = Fixed_kernels{ &FixedGraph<N>::get_girth, &FixedGraph<N>::is_chordal, &FixedGraph<N>::gen_proper_interval_ordering, &FixedGraph<N>::is_closed };
+		Fixed_table<N - 1>::fill(table);
+	}
+};
+
+template<>
+struct Fixed_table<0>
+{
+	static void fill(Fixed_kernels *) {}
+};
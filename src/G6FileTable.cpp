@@ -0,0 +1,390 @@
+#include "G6FileTable.h"
+#include "DatabaseInterface.h"
+
+#include <cstring>
+#include <algorithm>
+
+
+#define G6_HEADER ">>graph6<<"
+#define FULL_SCAN_COST 1000000.0
+
+
+//########## helper functions ##########
+/**
+ * returns the order of the graph given by a g6 line (63 or more for graphs too large to be decoded)
+**/
+inline unsigned g6_order(const char * line) {
+	return (unsigned char)line[0] - 63;
+}
+
+
+/**
+ * moves cursor to the next graph of its file with an order within its bounds, or sets eof if there is none
+**/
+void g6file_advance(G6_file_cursor * cursor) {
+	while (cursor->file->read_line(&cursor->line, &cursor->length))
+	{
+		if (cursor->length >= strlen(G6_HEADER)
+			&& strncmp(cursor->line, G6_HEADER, strlen(G6_HEADER)) == 0)
+		{
+			cursor->line += strlen(G6_HEADER);
+			cursor->length -= strlen(G6_HEADER);
+		}
+
+		if (cursor->length == 0)
+			continue;
+
+		cursor->rowid++;
+
+		unsigned order = g6_order(cursor->line);
+		if (order > 62
+			|| order < cursor->minimum_order
+			|| order > cursor->maximum_order)
+			continue;
+
+		cursor->decoded = false;
+		cursor->computed.assign(cursor->computed.size(), false);
+		return;
+	}
+
+	cursor->eof = true;
+}
+
+
+/**
+ * returns the graph at the current position of cursor, decoding it on first use
+ * returns 0 if the line cannot be decoded
+**/
+Graph * g6file_graph(G6_file_cursor * cursor) {
+	if (!cursor->decoded)
+	{
+		cursor->valid = cursor->graph.read_graph_from_g6(cursor->line, cursor->length);
+		cursor->decoded = true;
+	}
+	return cursor->valid ? &cursor->graph : 0;
+}
+
+
+//########## module functions ##########
+/**
+ * creates the table for the file given as the only argument (with or without quotation marks)
+**/
+int g6file_connect(sqlite3 * database, void * aux, int argc, const char * const * argv, sqlite3_vtab ** vtab, char ** error) {
+	if (argc != 4)
+	{
+		*error = sqlite3_mprintf("g6file expects exactly one file name.");
+		return SQLITE_ERROR;
+	}
+
+	std::string filename = argv[3];
+	if (filename.length() >= 2
+		&& (filename.front() == '\'' || filename.front() == '"')
+		&& filename.back() == filename.front())
+		filename = filename.substr(1, filename.length() - 2);
+
+	LineReader file(filename.c_str());
+	if (!file.is_open())
+	{
+		*error = sqlite3_mprintf("Unable to open '%s'.", filename.c_str());
+		return SQLITE_CANTOPEN;
+	}
+
+	G6_file_module * module = (G6_file_module *)aux;
+
+	std::string schema = "CREATE TABLE x(graphOrder INT, graphSize INT, edges TEXT, g6 BLOB";
+	for (unsigned i = 0; i < module->value_columns.size(); i++)
+	{
+		for (unsigned j = 0; j < module->value_columns[i].size(); j++)
+			schema += ", " + module->value_columns[i][j] + " INT";
+	}
+	for (unsigned i = 0; i < module->type_columns.size(); i++)
+		schema += ", " + module->type_columns[i] + " INT";
+	schema += ")";
+
+	int result = sqlite3_declare_vtab(database, schema.c_str());
+	if (result != SQLITE_OK)
+		return result;
+
+	G6_file_table * table = new G6_file_table();
+	table->filename = filename;
+	table->module = module;
+	*vtab = table;
+
+	return SQLITE_OK;
+}
+
+
+/**
+ * frees the table (the file itself is left untouched)
+**/
+int g6file_disconnect(sqlite3_vtab * vtab) {
+	delete static_cast<G6_file_table *>(vtab);
+	return SQLITE_OK;
+}
+
+
+/**
+ * hands all usable constraints on graphOrder to the scan, so that graphs of other orders are skipped before being decoded
+ * idxStr lists the operator of every constraint passed to g6file_filter
+**/
+int g6file_best_index(sqlite3_vtab * vtab, sqlite3_index_info * info) {
+	std::string operators = "";
+	double cost = FULL_SCAN_COST;
+
+	for (int i = 0; i < info->nConstraint; i++)
+	{
+		if (!info->aConstraint[i].usable
+			|| info->aConstraint[i].iColumn != 0)
+			continue;
+
+		char op;
+		switch (info->aConstraint[i].op)
+		{
+		case SQLITE_INDEX_CONSTRAINT_EQ: op = '='; cost /= 10; break;
+		case SQLITE_INDEX_CONSTRAINT_LT: op = '<'; cost /= 2; break;
+		case SQLITE_INDEX_CONSTRAINT_LE: op = 'l'; cost /= 2; break;
+		case SQLITE_INDEX_CONSTRAINT_GT: op = '>'; cost /= 2; break;
+		case SQLITE_INDEX_CONSTRAINT_GE: op = 'g'; cost /= 2; break;
+		default: continue;
+		}
+
+		operators.push_back(op);
+		info->aConstraintUsage[i].argvIndex = operators.length();
+		info->aConstraintUsage[i].omit = 1;
+	}
+
+	info->idxStr = sqlite3_mprintf("%s", operators.c_str());
+	info->needToFreeIdxStr = 1;
+	info->estimatedCost = cost;
+	info->estimatedRows = (sqlite3_int64)cost;
+
+	return SQLITE_OK;
+}
+
+
+/**
+ * opens a cursor on the file of the table
+**/
+int g6file_open(sqlite3_vtab * vtab, sqlite3_vtab_cursor ** vtab_cursor) {
+	G6_file_table * table = static_cast<G6_file_table *>(vtab);
+
+	G6_file_cursor * cursor = new G6_file_cursor();
+	cursor->file = 0;
+	cursor->eof = true;
+
+	unsigned getters = table->module->getters.size();
+	cursor->values.resize(getters);
+	cursor->computed.resize(getters, false);
+
+	*vtab_cursor = cursor;
+	return SQLITE_OK;
+}
+
+
+/**
+ * closes the cursor and unmaps the file
+**/
+int g6file_close(sqlite3_vtab_cursor * vtab_cursor) {
+	G6_file_cursor * cursor = static_cast<G6_file_cursor *>(vtab_cursor);
+	delete cursor->file;
+	delete cursor;
+	return SQLITE_OK;
+}
+
+
+/**
+ * starts a scan from the beginning of the file, restricted to the orders allowed by the constraints chosen by g6file_best_index
+**/
+int g6file_filter(sqlite3_vtab_cursor * vtab_cursor, int index_number, const char * index_string, int argc, sqlite3_value ** argv) {
+	G6_file_cursor * cursor = static_cast<G6_file_cursor *>(vtab_cursor);
+	G6_file_table * table = static_cast<G6_file_table *>(vtab_cursor->pVtab);
+
+	double minimum = 0;
+	double maximum = 62;
+
+	for (int i = 0; i < argc && index_string && index_string[i]; i++)
+	{
+		if (sqlite3_value_type(argv[i]) == SQLITE_NULL)
+		{
+			minimum = 1;
+			maximum = 0;
+			break;
+		}
+
+		double bound = sqlite3_value_double(argv[i]);
+
+		switch (index_string[i])
+		{
+		case '=':
+			minimum = std::max(minimum, ceil(bound));
+			maximum = std::min(maximum, floor(bound));
+			break;
+		case '<':
+			maximum = std::min(maximum, ceil(bound) - 1);
+			break;
+		case 'l':
+			maximum = std::min(maximum, floor(bound));
+			break;
+		case '>':
+			minimum = std::max(minimum, floor(bound) + 1);
+			break;
+		case 'g':
+			minimum = std::max(minimum, ceil(bound));
+			break;
+		}
+	}
+
+	cursor->minimum_order = minimum > maximum ? 1 : (unsigned)minimum;
+	cursor->maximum_order = minimum > maximum ? 0 : (unsigned)maximum;
+
+	delete cursor->file;
+	cursor->file = new LineReader(table->filename.c_str());
+	cursor->rowid = 0;
+	cursor->eof = false;
+
+	if (!cursor->file->is_open())
+	{
+		cursor->eof = true;
+		return SQLITE_CANTOPEN;
+	}
+
+	g6file_advance(cursor);
+	return SQLITE_OK;
+}
+
+
+/**
+ * moves the cursor to the next graph
+**/
+int g6file_next(sqlite3_vtab_cursor * vtab_cursor) {
+	g6file_advance(static_cast<G6_file_cursor *>(vtab_cursor));
+	return SQLITE_OK;
+}
+
+
+/**
+ * returns whether the scan is done
+**/
+int g6file_eof(sqlite3_vtab_cursor * vtab_cursor) {
+	return static_cast<G6_file_cursor *>(vtab_cursor)->eof;
+}
+
+
+/**
+ * returns the value of given column of the current graph, computing values and types only when asked for
+ * raises an SQL error for all columns but graphOrder and g6 if the graph cannot be decoded, just like the graph functions
+**/
+int g6file_column(sqlite3_vtab_cursor * vtab_cursor, sqlite3_context * context, int column) {
+	G6_file_cursor * cursor = static_cast<G6_file_cursor *>(vtab_cursor);
+	G6_file_module * module = static_cast<G6_file_table *>(vtab_cursor->pVtab)->module;
+
+	switch (column)
+	{
+	case 0:
+		sqlite3_result_int(context, g6_order(cursor->line));
+		return SQLITE_OK;
+	case 3:
+		sqlite3_result_blob(context, cursor->line, cursor->length, SQLITE_TRANSIENT);
+		return SQLITE_OK;
+	}
+
+	if (!g6file_graph(cursor))
+	{
+		sqlite3_result_error(context, "invalid graph", -1);
+		return SQLITE_OK;
+	}
+
+	switch (column)
+	{
+	case 1:
+		sqlite3_result_int(context, g6file_graph(cursor)->get_size());
+		return SQLITE_OK;
+	case 2:
+		sqlite3_result_text(context, g6file_graph(cursor)->convert_to_string().c_str(), -1, SQLITE_TRANSIENT);
+		return SQLITE_OK;
+	}
+
+	unsigned index = column - 4;
+
+	for (unsigned i = 0; i < module->getters.size(); i++)
+	{
+		if (index >= module->value_columns[i].size())
+		{
+			index -= module->value_columns[i].size();
+			continue;
+		}
+
+		if (!cursor->computed[i])
+		{
+			cursor->values[i] = (g6file_graph(cursor)->*module->getters[i])();
+			cursor->computed[i] = true;
+		}
+
+		if (index >= cursor->values[i].size()
+			|| cursor->values[i][index] == NULL_VALUE)
+			sqlite3_result_null(context);
+		else
+			sqlite3_result_int64(context, cursor->values[i][index]);
+		return SQLITE_OK;
+	}
+
+	if (index < module->tests.size())
+		sqlite3_result_int(context, (g6file_graph(cursor)->*module->tests[index])() ? 1 : 0);
+	else
+		sqlite3_result_null(context);
+
+	return SQLITE_OK;
+}
+
+
+/**
+ * returns the number of the current graph within the file
+**/
+int g6file_rowid(sqlite3_vtab_cursor * vtab_cursor, sqlite3_int64 * rowid) {
+	*rowid = static_cast<G6_file_cursor *>(vtab_cursor)->rowid;
+	return SQLITE_OK;
+}
+
+
+/**
+ * frees the module description once SQLite drops the module
+**/
+void g6file_destroy_module(void * module) {
+	delete (G6_file_module *)module;
+}
+
+
+sqlite3_module G6_FILE_MODULE = {
+	0,					// iVersion
+	g6file_connect,		// xCreate
+	g6file_connect,		// xConnect
+	g6file_best_index,	// xBestIndex
+	g6file_disconnect,	// xDisconnect
+	g6file_disconnect,	// xDestroy
+	g6file_open,		// xOpen
+	g6file_close,		// xClose
+	g6file_filter,		// xFilter
+	g6file_next,		// xNext
+	g6file_eof,			// xEof
+	g6file_column,		// xColumn
+	g6file_rowid,		// xRowid
+	0,					// xUpdate
+	0,					// xBegin
+	0,					// xSync
+	0,					// xCommit
+	0,					// xRollback
+	0,					// xFindFunction
+	0,					// xRename
+	0,					// xSavepoint
+	0,					// xRelease
+	0,					// xRollbackTo
+	0					// xShadowName
+};
+
+
+/**
+ * registers the g6file module with the database, which takes ownership of module
+**/
+int create_g6file_module(sqlite3 * database, G6_file_module * module) {
+	return sqlite3_create_module_v2(database, "g6file", &G6_FILE_MODULE, module, &g6file_destroy_module);
+}
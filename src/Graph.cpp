@@ -1,375 +1,295 @@
 #include "Graph.h"
+#include "FixedGraph.h"
 
 #include <list>
+#include <algorithm>
 
 
 //########## helper functions ##########
 /**
- * returns the appropriate index of the array in which the adjacency matrix is stored
+ * returns the mask containing only the given vertex
 **/
-inline unsigned get_index(unsigned first_vertex, unsigned second_vertex, unsigned order) {
-	return (first_vertex - 1) * order + second_vertex - 1;
+inline uint64_t get_bit(unsigned vertex) {
+	return (uint64_t)1 << (vertex - 1);
 }
 
 
 /**
- * returns x to the power of n
+ * returns the mask containing all vertices of a graph of given order
 **/
-inline unsigned nth_power(unsigned x, unsigned n) {
-	if (x == 0)
-		return 0;
-
-	unsigned power = 1;
-
-	for (unsigned i = 0; i < n; i++)
-		power *= x;
-
-	return power;
+inline uint64_t get_all_bits(unsigned order) {
+	return ((uint64_t)1 << order) - 1;
 }
 
 
 /**
-* Brian Kernighan's algorithm to count set bits in integer (counts ones in binary representation)
+ * returns the mask of the lowest number_bits bits (at most 63)
 **/
-inline unsigned count_set_bits(int n)
-{
-	unsigned count = 0;
-	while (n)
-	{
-		n &= (n - 1);
-		count++;
-	}
-	return count;
+inline uint64_t get_low_bits(unsigned number_bits) {
+	return ((uint64_t)1 << number_bits) - 1;
 }
 
 
-//########## private member functions ##########
 /**
-* recursively adds all inclusion-maximal cliques to max_cliques and returns the current clique number via Bron-Kerbosch algorithm with pivots
+ * reverses the order of the lower 6 bits in every byte of word, whose upper 2 bits have to be 0
+ * the bits of a Graph6 character are written most significant first, so this converts between a character and its 6 bits in the order of the bit stream
 **/
-unsigned Graph::bron_kerbosch_pivot(std::vector<std::vector<unsigned>> * max_cliques, unsigned clique_number, std::vector<unsigned> * include_all, std::vector<unsigned> * include_some, std::vector<unsigned> * include_none) {
-	if (include_some->empty()
-		&& include_none->empty())
-	{
-		max_cliques->push_back(*include_all);
-		unsigned size = include_all->size();
-		return clique_number < size ? size : clique_number;
-	}
-
-	unsigned new_clique_number = clique_number;
-
-	unsigned pivot = !include_some->empty() ? include_some->back() : include_all->back();
-	for (unsigned i = 0; i < include_some->size();)
-	{
-		unsigned v = include_some->at(i);
-		if (!adjacent(pivot, v))
-		{
-			std::vector<unsigned> new_all;
-			std::vector<unsigned> new_some;
-			std::vector<unsigned> new_none;
-			unsigned all_size = include_all->size();
-			unsigned some_size = include_some->size();
-			unsigned none_size = include_none->size();
-
-			for (unsigned j = 0; j < order; j++)
-			{
-				if (j < all_size)
-					new_all.push_back(include_all->at(j));
-
-				if (j < some_size)
-				{
-					unsigned w = include_some->at(j);
-					if (adjacent(v, w))
-						new_some.push_back(w);
-				}
+inline uint64_t reverse_sextets(uint64_t word) {
+	word = ((word >> 1) & 0x5555555555555555) | ((word & 0x5555555555555555) << 1);
+	word = ((word >> 2) & 0x3333333333333333) | ((word & 0x3333333333333333) << 2);
+	word = ((word >> 4) & 0x0F0F0F0F0F0F0F0F) | ((word & 0x0F0F0F0F0F0F0F0F) << 4);
+	return (word >> 2) & 0x3F3F3F3F3F3F3F3F;
+}
 
-				if (j < none_size)
-				{
-					unsigned w = include_none->at(j);
-					if (adjacent(v, w))
-						new_none.push_back(w);
-				}
-			}
-			new_all.push_back(v);
 
-			unsigned recursive_clique_number = bron_kerbosch_pivot(max_cliques, clique_number, &new_all, &new_some, &new_none);
-			if (new_clique_number < recursive_clique_number)
-				new_clique_number = recursive_clique_number;
+/**
+ * returns the 48 bits of the bit stream given by 8 Graph6 characters (the first bit of the stream being the lowest)
+ * all characters are converted at once within one word, the characters are expected to be valid (at least 63)
+**/
+inline uint64_t unpack_g6_characters(const char * g6) {
+	uint64_t word = 0;
+	for (unsigned i = 0; i < 8; i++)
+		word |= (uint64_t)(unsigned char)g6[i] << (8 * i);
 
-			include_some->erase(include_some->begin() + i);
-			include_none->push_back(v);
-		}
-		else
-			i++;
-	}
+	// (c - 63) mod 64 == (c + 1) mod 64, without borrows between the bytes
+	word = reverse_sextets(((word & 0x3F3F3F3F3F3F3F3F) + 0x0101010101010101) & 0x3F3F3F3F3F3F3F3F);
 
-	return new_clique_number;
+	word = (word & 0x003F003F003F003F) | ((word & 0x3F003F003F003F00) >> 2);
+	word = (word & 0x00000FFF00000FFF) | ((word & 0x0FFF00000FFF0000) >> 4);
+	return (word & 0x0000000000FFFFFF) | ((word & 0x00FFFFFF00000000) >> 8);
 }
 
 
 /**
- * tests if a given subset in binary representation of order subset_order is an induced connected subgraph via depth-first-search
+ * appends the 8 Graph6 characters encoding the lowest 48 bits of the bit stream given by bits (the first bit of the stream being the lowest) to g6
 **/
-bool Graph::is_induced_connected(unsigned * vertices, unsigned subset_order) {
-	if (subset_order < 2)
-		return true;
-
-	bool * visited = new bool[subset_order];
-	std::vector<unsigned> stack = { vertices[0] };
+inline void pack_g6_characters(uint64_t bits, std::string * g6) {
+	uint64_t word = bits & 0x0000FFFFFFFFFFFF;
+	word = (word & 0x0000000000FFFFFF) | ((word & 0x0000FFFFFF000000) << 8);
+	word = (word & 0x00000FFF00000FFF) | ((word & 0x00FFF00000FFF000) << 4);
+	word = (word & 0x003F003F003F003F) | ((word & 0x0FC00FC00FC00FC0) << 2);
+
+	word = reverse_sextets(word) + 0x3F3F3F3F3F3F3F3F;
+
+	char characters[8];
+	for (unsigned i = 0; i < 8; i++)
+		characters[i] = (char)(word >> (8 * i));
+	g6->append(characters, 8);
+}
 
-	visited[0] = true;
-	for (unsigned i = 1; i < subset_order; i++)
-		visited[i] = false;
 
-	while (!stack.empty())
-	{
-		unsigned current = stack.back();
-		stack.pop_back();
+/**
+* dispatch table of the kernels compiled for every order up to FIXED_MAX_ORDER, filled once at startup
+**/
+struct Fixed_dispatch
+{
+	Fixed_kernels table[FIXED_MAX_ORDER + 1];
 
-		for (unsigned i = 0; i < subset_order; i++)
-		{
-			unsigned neighbor = vertices[i];
-			if (!visited[i]
-				&& adjacent(current, neighbor))
-			{
-				stack.push_back(neighbor);
-				visited[i] = true;
-			}
-		}
+	Fixed_dispatch() {
+		table[0] = Fixed_kernels{ 0, 0, 0, 0 };
+		Fixed_table<FIXED_MAX_ORDER>::fill(table);
 	}
+};
 
-	for (unsigned i = 1; i < subset_order; i++)
-	{
-		if (!visited[i])
-		{
-			delete[] visited;
-			return false;
-		}
-	}
-
-	delete[] visited;
-	return true;
-}
+static const Fixed_dispatch fixed_dispatch;
 
 
 /**
-* tests if a given subset in binary representation of order subset_order is an induced path
-* this is done by tallying up degrees, checking for invalid degrees, computing the check sum of degrees and checking if the induced subgraph is connected
+ * returns the kernels for graphs of given order, which has to be between 1 and FIXED_MAX_ORDER
 **/
-bool Graph::is_induced_path(int subset, unsigned subset_order) {
-	unsigned * degrees = new unsigned[subset_order];
-	unsigned * vertices = new unsigned[subset_order];
+const Fixed_kernels & Fixed_kernels::get(unsigned order) {
+	return fixed_dispatch.table[order];
+}
 
-	for (unsigned i = 0, v = 1; i < subset_order; i++, v++)
-	{
-		degrees[i] = 0;
-		while (!(subset & (1 << (order - v))))
-			v++;
-		vertices[i] = v;
-	}
 
-	for (unsigned i = 0; i < subset_order; i++)
+//########## private member functions ##########
+/**
+* recursively counts all inclusion-maximal cliques and updates the clique number via Bron-Kerbosch algorithm with Tomita pivoting
+* cliques are taken with respect to the given neighbour masks (e.g., those of the complement for independent sets), the current clique is only tracked by its size
+**/
+void Graph::bron_kerbosch_pivot(const uint64_t * rows, unsigned clique_size, uint64_t include_some, uint64_t include_none, unsigned * clique_number, unsigned * max_cliques) {
+	if (include_some == 0)
 	{
-		for (unsigned j =  i + 1; j < subset_order; j++)
+		if (include_none == 0)
 		{
-			if (adjacent(vertices[i], vertices[j]))
-			{
-				degrees[i]++;
-				degrees[j]++;
-			}
+			(*max_cliques)++;
+			if (*clique_number < clique_size)
+				*clique_number = clique_size;
 		}
+		return;
 	}
 
-	unsigned check_sum_degrees = 0;
+	unsigned pivot = 0;
+	unsigned max_neighbours = 0;
 
-	for (unsigned i = 0; i < subset_order; i++)
+	for (uint64_t rest = include_some | include_none; rest; rest &= rest - 1)
 	{
-		if (degrees[i] != 1
-			&& degrees[i] != 2)
+		unsigned u = lowest_set_bit(rest);
+		unsigned neighbours = count_set_bits(include_some & rows[u]);
+
+		if (neighbours >= max_neighbours)
 		{
-				delete[] degrees;
-				delete[] vertices;
-				return false;
+			pivot = u;
+			max_neighbours = neighbours;
 		}
-		check_sum_degrees += degrees[i];
 	}
 
-	if (check_sum_degrees != (subset_order - 1) * 2)
+	for (uint64_t rest = include_some & ~rows[pivot]; rest; rest &= rest - 1)
 	{
-		delete[] vertices;
-		delete[] degrees;
-		return false;
+		unsigned v = lowest_set_bit(rest);
+		uint64_t bit = (uint64_t)1 << v;
+
+		bron_kerbosch_pivot(rows, clique_size + 1, include_some & rows[v], include_none & rows[v], clique_number, max_cliques);
+
+		include_some &= ~bit;
+		include_none |= bit;
 	}
+}
 
-	bool connected = subset_order <= 4 || is_induced_connected(vertices, subset_order);
 
-	delete[] vertices;
-	delete[] degrees;
+/**
+ * tests if the subgraph induced by given subset of vertices is connected
+**/
+bool Graph::is_induced_connected(uint64_t subset) {
+	if (count_set_bits(subset) < 2)
+		return true;
 
-	return connected;
+	return get_reachable(lowest_set_bit(subset) + 1, subset) == subset;
 }
 
 
 /**
-* tests if a given order-4-subset of vertices is an induced claw
-* this is done by tallying up degrees, checking for invalid degrees and computing the check sum of degrees
+ * returns the mask of all vertices reachable from given vertex in the subgraph induced by allowed (and the vertex itself)
+ * if complement is set, the search runs in the complement graph instead
 **/
-bool Graph::is_induced_claw(int subset) {
-	unsigned * degrees = new unsigned[4];
-	unsigned * vertices = new unsigned[4];
+uint64_t Graph::get_reachable(unsigned vertex, uint64_t allowed, bool complement) {
+	uint64_t reached = get_bit(vertex);
+	uint64_t frontier = reached;
 
-	for (unsigned i = 0, v = 1; i < 4; i++, v++)
+	while (frontier)
 	{
-		degrees[i] = 0;
-		while (!(subset & (1 << (order - v))))
-			v++;
-		vertices[i] = v;
-	}
+		uint64_t next = 0;
 
-	for (unsigned i = 0; i < 4; i++)
-	{
-		for (unsigned j = i + 1; j < 4; j++)
-		{
-			if (adjacent(vertices[i], vertices[j]))
-			{
-				degrees[i]++;
-				degrees[j]++;
-			}
-		}
-	}
-
-	delete[] vertices;
-
-	unsigned check_sum_degrees = 0;
+		for (uint64_t rest = frontier; rest; rest &= rest - 1)
+			next |= complement ? ~adjacencies[lowest_set_bit(rest)] : adjacencies[lowest_set_bit(rest)];
 
-	for (unsigned i = 0; i < 4; i++)
-	{
-		if (degrees[i] != 1
-			&& degrees[i] != 3)
-		{
-			delete[] degrees;
-			return false;
-		}
-		check_sum_degrees += degrees[i];
+		frontier = next & allowed & ~reached;
+		reached |= frontier;
 	}
 
-	delete[] degrees;
-
-	return check_sum_degrees == 6;
+	return reached;
 }
 
 
 /**
-* tests if given vertex is universal, i.e. it is adjacent to all other vertices of the graph
+ * recursively extends an induced path ending in last with given length by one neighbour of last at a time, keeping max_detour up to date
+ * blocked contains all vertices of the path and all neighbours of its vertices except last, i.e., all vertices which can no longer be appended
+ * branches are cut as soon as the vertices still reachable from the path's end cannot yield a path longer than max_detour
 **/
-bool Graph::is_universal(unsigned vertex) {
-	for (unsigned w = 1; w <= order; w++)
-		if (w != vertex
-			&& !adjacent(vertex, w))
-			return false;
+void Graph::extend_induced_path(unsigned last, unsigned length, uint64_t blocked, unsigned bound, unsigned * max_detour) {
+	if (*max_detour < length)
+		*max_detour = length;
 
-	return true;
+	uint64_t new_blocked = blocked | adjacencies[last - 1];
+
+	for (uint64_t rest = adjacencies[last - 1] & ~blocked; rest && *max_detour < bound; rest &= rest - 1)
+	{
+		unsigned next = lowest_set_bit(rest) + 1;
+		uint64_t reachable = get_reachable(next, get_all_bits(order) & ~new_blocked);
+
+		if (length + count_set_bits(reachable) <= *max_detour)
+			continue;
+
+		extend_induced_path(next, length + 1, new_blocked, bound, max_detour);
+	}
 }
 
 
 /**
-* tests if the given vertex is simplicial, i.e., its neighbors form a clique, with respect to the subgraph induced by the vertices which have not been visited
+ * recursively decomposes the subgraph induced by subset into its connected components or, if it is connected, into the connected components of its complement
+ * adds the resulting union or join node below parent to cotree (unless cotree is 0) and returns false as soon as neither decomposition splits the subset,
+ * i.e., the subgraph is no cograph
 **/
-bool Graph::is_simplicial(unsigned vertex, bool * visited) {
-	for (unsigned v = 1; v <= order; v++)
+bool Graph::build_cotree(Cotree * cotree, uint64_t subset, int parent) {
+	if (count_set_bits(subset) == 1)
 	{
-		if (!visited[v - 1]
-			&& adjacent(vertex, v))
-		{
-			for (unsigned w = v + 1; w <= order; w++)
-			{
-				if (!visited[w - 1]
-					&& adjacent(vertex, w)
-					&& !adjacent(v, w))
-					return false;
-			}
-		}
+		if (cotree)
+			cotree->add_node(LEAF_NODE, lowest_set_bit(subset) + 1, parent);
+		return true;
 	}
 
-	return true;
-}
+	uint64_t component = get_reachable(lowest_set_bit(subset) + 1, subset);
+	bool complement = false;
 
+	if (component == subset)
+	{
+		component = get_reachable(lowest_set_bit(subset) + 1, subset, true);
+		complement = true;
 
-/**
-* returns a pair of simplicial vertices of the subgraph induced by the vertices which have not been visited
-* expects the subgraph to have at least two simplicial vertices (this is the case, e.g., if the graph is chordal)
-**/
-std::pair<unsigned, unsigned> Graph::get_simplicial_pair(bool * visited) {
-	unsigned first = 0;
-	unsigned second = 0;
+		if (component == subset)
+			return false;
+	}
 
-	for (unsigned v = 1; v <= order; v++)
+	int node = cotree ? cotree->add_node(complement ? JOIN_NODE : UNION_NODE, 0, parent) : -1;
+
+	while (true)
 	{
-		if (!visited[v - 1]
-			&& is_simplicial(v, visited))
-		{
-			if (first == 0)
-				first = v;
-			else
-			{
-				second = v;
-				break;
-			}
-		}
+		if (!build_cotree(cotree, component, node))
+			return false;
+
+		subset &= ~component;
+		if (!subset)
+			return true;
+
+		component = get_reachable(lowest_set_bit(subset) + 1, subset, complement);
 	}
+}
+
 
-	return std::pair<unsigned, unsigned>(first, second);
+/**
+* tests if given vertex is universal, i.e. it is adjacent to all other vertices of the graph
+**/
+bool Graph::is_universal(unsigned vertex) {
+	return (adjacencies[vertex - 1] | get_bit(vertex)) == get_all_bits(order);
 }
 
 
 /**
- * generates a lexicographic ordering on the vertices of the graph via lexicographic-breadth-first-search using partition refinement
+ * generates a lexicographic ordering on the vertices of the graph via lexicographic-breadth-first-search using partition refinement on vertex masks
 **/
 std::pair<unsigned *, unsigned *> Graph::gen_lexicographic_ordering() {
 	if (order == 0)
 		return {};
 
-	std::list<std::vector<unsigned>> partitions;
-	std::vector<unsigned> initial_list;
-
-	for (unsigned v = 1; v <= order; v++)
-		initial_list.push_back(v);
-
-	partitions.push_back(initial_list);
+	std::vector<uint64_t> partitions = { get_all_bits(order) };
+	std::vector<uint64_t> refined;
 
 	unsigned * ordering = new unsigned[order];
 	unsigned * ordering_indices = new unsigned[order];
 
 	for (int i = order - 1; i >= 0; i--)
 	{
-		unsigned v = partitions.back().back();
-		partitions.back().pop_back();
-		if (partitions.back().empty())
+		unsigned v = highest_set_bit(partitions.back());
+
+		partitions.back() &= ~((uint64_t)1 << v);
+		if (partitions.back() == 0)
 			partitions.pop_back();
 
-		ordering[i] = v;
-		ordering_indices[v - 1] = i;
+		ordering[i] = v + 1;
+		ordering_indices[v] = i;
 
-		std::list<std::vector<unsigned>>::iterator it;
-		for (it = partitions.begin(); it != partitions.end();)
+		refined.clear();
+		for (uint64_t partition : partitions)
 		{
-			std::vector<unsigned> intersection;
-			std::vector<unsigned> difference;
-
-			for (unsigned w : *it)
-			{
-				if (adjacent(v, w))
-					intersection.push_back(w);
-				else
-					difference.push_back(w);
-			}
+			uint64_t intersection = partition & adjacencies[v];
+			uint64_t difference = partition & ~adjacencies[v];
 
-			it = partitions.erase(it);
-			if (!difference.empty())
-				partitions.insert(it, difference);
-			if (!intersection.empty())
-				partitions.insert(it, intersection);
+			if (difference)
+				refined.push_back(difference);
+			if (intersection)
+				refined.push_back(intersection);
 		}
+		partitions.swap(refined);
 	}
 
 	return { ordering, ordering_indices };
@@ -377,204 +297,278 @@ std::pair<unsigned *, unsigned *> Graph::gen_lexicographic_ordering() {
 
 
 /**
-* tests if the vertices in given perfect elimination ordering at index t and t+1 are swappable, i.e. the peo with these vertices swapped is a peo as well
+ * generates an ordering of the vertices via lexicographic-breadth-first-search, listing them in the order they are visited
+ * ties are broken in favour of the vertex appearing last in the previous ordering given by previous_indices (LexBFS+), or of the highest vertex if there is none
 **/
-bool Graph::peo_swappable(unsigned * peo, unsigned * h, int t) {
-	if (t == ((int)order) - 1)
-		return false;
+void Graph::gen_lexicographic_ordering_plus(unsigned * previous_indices, unsigned * ordering, unsigned * ordering_indices) {
+	std::vector<uint64_t> partitions = { get_all_bits(order) };
+	std::vector<uint64_t> refined;
+
+	for (unsigned i = 0; i < order; i++)
+	{
+		unsigned v = highest_set_bit(partitions.back());
+
+		if (previous_indices)
+		{
+			for (uint64_t rest = partitions.back(); rest; rest &= rest - 1)
+			{
+				unsigned w = lowest_set_bit(rest);
+				if (previous_indices[w] > previous_indices[v])
+					v = w;
+			}
+		}
 
-	unsigned x = peo[t];
-	unsigned y = peo[t + 1];
+		partitions.back() &= ~((uint64_t)1 << v);
+		if (partitions.back() == 0)
+			partitions.pop_back();
+
+		ordering[i] = v + 1;
+		ordering_indices[v] = i;
+
+		refined.clear();
+		for (uint64_t partition : partitions)
+		{
+			uint64_t intersection = partition & adjacencies[v];
+			uint64_t difference = partition & ~adjacencies[v];
 
-	return !adjacent(x, y) || h[x - 1] == h[y - 1] + 1;
+			if (difference)
+				refined.push_back(difference);
+			if (intersection)
+				refined.push_back(intersection);
+		}
+		partitions.swap(refined);
+	}
 }
 
 
 /**
-* swaps the vertices in given given perfect elimination ordering at index t and t+1 and tests if the graph is closed with respect to the induced labeling
+ * generates a candidate for a proper interval ordering via three sweeps of LexBFS+ (Corneil), the last one being written to ordering
+ * returns true if it is a proper interval ordering, i.e., the closed neighbourhood of every vertex is consecutive in the ordering
+ * this is the case if and only if the graph is a proper interval graph
+ * graphs of order up to FIXED_MAX_ORDER are handled by the kernel of FixedGraph compiled for their order
 **/
-bool Graph::peo_move(unsigned * peo, unsigned * peo_indices, unsigned * h, int t) {
-	unsigned x = peo[t];
-	unsigned y = peo[t + 1];
+bool Graph::gen_proper_interval_ordering(unsigned * ordering) {
+	if (order >= 1
+		&& order <= FIXED_MAX_ORDER)
+	{
+		bool proper = Fixed_kernels::get(order).gen_proper_interval_ordering(adjacencies, ordering);
+		for (unsigned i = 0; i < order; i++)
+			ordering[i]++;
+		return proper;
+	}
 
-	peo[t] = y;
-	peo[t + 1] = x;
-	unsigned temp = peo_indices[x - 1];
-	peo_indices[x - 1] = peo_indices[y - 1];
-	peo_indices[y - 1] = temp;
+	unsigned * sweep_indices = new unsigned[order];
+	unsigned * previous_indices = new unsigned[order];
 
-	if (adjacent(x, y))
+	gen_lexicographic_ordering_plus(0, ordering, sweep_indices);
+	for (unsigned sweep = 2; sweep <= 3; sweep++)
 	{
-		h[x - 1]--;
-		h[y - 1]++;
+		std::swap(sweep_indices, previous_indices);
+		gen_lexicographic_ordering_plus(previous_indices, ordering, sweep_indices);
 	}
 
-	return is_closed_wrt_labeling(peo, peo_indices);
+	bool proper = true;
+	for (unsigned i = 0; i < order && proper; i++)
+	{
+		uint64_t neighbourhood = (uint64_t)1 << i;
+		for (uint64_t rest = adjacencies[ordering[i] - 1]; rest; rest &= rest - 1)
+			neighbourhood |= (uint64_t)1 << sweep_indices[lowest_set_bit(rest)];
+
+		proper = ((neighbourhood + (neighbourhood & (~neighbourhood + 1))) & neighbourhood) == 0;
+	}
+
+	delete[] sweep_indices;
+	delete[] previous_indices;
+	return proper;
 }
 
 
 /**
-* a special swap where the order of the t-th pair of simplicial vertices is swapped
-* also tests if the graph is closed with respect to the new labeling
+ * refines the ordered partition of the vertex indices given by cells (as masks) until it is equitable, i.e., all vertices of a cell have equally many neighbours in every cell
+ * a cell is split by the number of neighbours in another cell and its parts replace it in ascending order of that number, so the result does not depend on the labeling
 **/
-bool Graph::peo_switch(unsigned * peo, unsigned * peo_indices, unsigned * h, unsigned * a, unsigned * b, int t) {
-	if (t != -1)
+void Graph::refine_partition(std::vector<uint64_t> * cells) {
+	bool changed = true;
+
+	while (changed)
 	{
-		unsigned x = a[t];
-		unsigned y = b[t];
-
-		unsigned temp = peo[peo_indices[x - 1]];
-		peo[peo_indices[x - 1]] = peo[peo_indices[y - 1]];
-		peo[peo_indices[y - 1]] = temp;
-		temp = peo_indices[x - 1];
-		peo_indices[x - 1] = peo_indices[y - 1];
-		peo_indices[y - 1] = temp;
-		temp = a[t];
-		a[t] = b[t];
-		b[t] = temp;
-
-		if (adjacent(x, y))
+		changed = false;
+
+		for (unsigned s = 0; s < cells->size(); s++)
 		{
-			h[x - 1]--;
-			h[y - 1]++;
+			uint64_t splitter = cells->at(s);
+
+			for (unsigned c = 0; c < cells->size(); c++)
+			{
+				uint64_t cell = cells->at(c);
+				if ((cell & (cell - 1)) == 0)
+					continue;
+
+				uint64_t parts[63] = {};
+				unsigned minimum = 62;
+				unsigned maximum = 0;
+
+				for (uint64_t rest = cell; rest; rest &= rest - 1)
+				{
+					unsigned v = lowest_set_bit(rest);
+					unsigned neighbours = count_set_bits(adjacencies[v] & splitter);
+
+					parts[neighbours] |= (uint64_t)1 << v;
+					minimum = std::min(minimum, neighbours);
+					maximum = std::max(maximum, neighbours);
+				}
+
+				if (minimum == maximum)
+					continue;
+
+				std::vector<uint64_t> split;
+				for (unsigned k = minimum; k <= maximum; k++)
+				{
+					if (parts[k])
+						split.push_back(parts[k]);
+				}
+
+				cells->erase(cells->begin() + c);
+				cells->insert(cells->begin() + c, split.begin(), split.end());
+				c += split.size() - 1;
+				changed = true;
+			}
 		}
 	}
-
-	return is_closed_wrt_labeling(peo, peo_indices);
 }
 
 
 /**
-* recursively iterates through all perfect elimination orderings of the graph (twice) by swapping consecutive elements
-* returns true as soon as an ordering is found for which the graph is closed with respect to the induced labeling
+ * explores the search tree of individualization and refinement below the partition cells, which was reached by individualizing the vertex indices in path
+ * a leaf (a discrete partition) labels every vertex by the position of its cell, the largest relabelled adjacency rows found are kept as best leaf
+ * a leaf equal to the first or best leaf yields an automorphism, children of a node lying in the same orbit under the automorphisms fixing its path are explored only once
+ * returns the depth to which the search jumps back, which is less than the depth of path if the rest of its subtree is mapped by an automorphism onto a subtree explored before
 **/
-bool Graph::test_pe_orderings(unsigned * peo, unsigned * peo_indices, unsigned * h, unsigned * a, unsigned * b, unsigned i) {
-	if (i == 0)
-		return false;
+unsigned Graph::search_canonical_labeling(std::vector<uint64_t> * cells, std::vector<unsigned> * path, Canonical_search * search) {
+	unsigned depth = path->size();
+	refine_partition(cells);
 
-	if (test_pe_orderings(peo, peo_indices, h, a, b, i - 1))
-		return true;
+	unsigned target = 0;
+	while (target < cells->size()
+		&& (cells->at(target) & (cells->at(target) - 1)) == 0)
+		target++;
 
-	unsigned mrb = 0;
-	bool typical = false;
-
-	while (peo_swappable(peo, h, peo_indices[b[i - 1] - 1]))
+	if (target == cells->size())
 	{
-		mrb++;
-		if (peo_move(peo, peo_indices, h, peo_indices[b[i - 1] - 1])
-			|| test_pe_orderings(peo, peo_indices, h, a, b, i - 1))
-			return true;
-
-		unsigned mra = 0;
-		if (peo[peo_indices[a[i - 1] - 1] + 1] != b[i - 1]
-			&& peo_swappable(peo, h, peo_indices[a[i - 1] - 1]))
+		std::vector<unsigned> labeling(order);
+		std::vector<unsigned> labels(order);
+		for (unsigned i = 0; i < order; i++)
 		{
-			typical = true;
-			do
-			{
-				mra++;
-				if (peo_move(peo, peo_indices, h, peo_indices[a[i - 1] - 1])
-					|| test_pe_orderings(peo, peo_indices, h, a, b, i - 1))
-					return true;
+			labeling[i] = lowest_set_bit(cells->at(i));
+			labels[labeling[i]] = i;
+		}
 
-			} while (peo[peo_indices[a[i - 1] - 1] + 1] != b[i - 1]
-				&& peo_swappable(peo, h, peo_indices[a[i - 1] - 1]));
+		std::vector<uint64_t> rows(order, 0);
+		for (unsigned i = 0; i < order; i++)
+		{
+			for (uint64_t rest = adjacencies[labeling[i]]; rest; rest &= rest - 1)
+				rows[i] |= (uint64_t)1 << labels[lowest_set_bit(rest)];
 		}
 
-		if (typical)
+		if (search->first_rows.empty())
 		{
-			if (peo_switch(peo, peo_indices, h, a, b, i - 2)
-				|| test_pe_orderings(peo, peo_indices, h, a, b, i - 1))
-				return true;
+			search->first_path = search->best_path = *path;
+			search->first_labeling = search->best_labeling = labeling;
+			search->first_rows = search->best_rows = rows;
+			return depth;
+		}
 
-			unsigned mla;
-			if (mrb % 2 == 1)
-				mla = mra - 1;
-			else
-				mla = mra + 1;
+		std::vector<unsigned> * equal_path = 0;
+		std::vector<unsigned> * equal_labeling = 0;
 
-			for (unsigned j = 1; j <= mla; j++)
-			{
-				if (peo_move(peo, peo_indices, h, peo_indices[a[i - 1] - 1] - 1)
-					|| test_pe_orderings(peo, peo_indices, h, a, b, i - 1))
-					return true;
-			}
+		if (rows == search->first_rows)
+		{
+			equal_path = &search->first_path;
+			equal_labeling = &search->first_labeling;
+		}
+		else if (rows == search->best_rows)
+		{
+			equal_path = &search->best_path;
+			equal_labeling = &search->best_labeling;
 		}
-	}
 
-	if (typical
-		&& mrb % 2 == 1)
-	{
-		if (peo_move(peo, peo_indices, h, peo_indices[a[i - 1] - 1] - 1))
-			return true;
+		if (equal_path)
+		{
+			std::vector<unsigned> automorphism(order);
+			for (unsigned i = 0; i < order; i++)
+				automorphism[equal_labeling->at(i)] = labeling[i];
+			search->automorphisms.push_back(automorphism);
+
+			unsigned common = 0;
+			while (common < depth
+				&& path->at(common) == equal_path->at(common))
+				common++;
+			return common;
+		}
+
+		if (rows > search->best_rows)
+		{
+			search->best_path = *path;
+			search->best_labeling = labeling;
+			search->best_rows = rows;
+		}
+		return depth;
 	}
-	else if (peo_switch(peo, peo_indices, h, a, b, i - 2))
-		return true;
 
-	if (test_pe_orderings(peo, peo_indices, h, a, b, i - 1))
-		return true;
+	uint64_t cell = cells->at(target);
+	std::vector<unsigned> explored;
 
-	for (unsigned j = 1; j <= mrb; j++)
+	for (uint64_t rest = cell; rest; rest &= rest - 1)
 	{
-		if (peo_move(peo, peo_indices, h, peo_indices[b[i - 1] - 1] - 1)
-			|| test_pe_orderings(peo, peo_indices, h, a, b, i - 1))
-			return true;
-	}
+		unsigned v = lowest_set_bit(rest);
 
-	return false;
-}
+		std::vector<unsigned> orbits(order);
+		for (unsigned i = 0; i < order; i++)
+			orbits[i] = i;
 
+		auto find = [&orbits](unsigned i) {
+			while (orbits[i] != i)
+				i = orbits[i] = orbits[orbits[i]];
+			return i;
+		};
 
-/**
-* generates an initial perfect elimination ordering via consecutive elimination of pairs of simplicial vertices
-**/
-void Graph::gen_initial_peo(unsigned * peo, unsigned * peo_indices, unsigned * h, unsigned * a, unsigned * b) {
-	bool * visited = new bool[order];
-	for (unsigned i = 0; i < order; i++)
-		visited[i] = false;
+		for (unsigned k = 0; k < search->automorphisms.size(); k++)
+		{
+			std::vector<unsigned> * automorphism = &search->automorphisms[k];
 
-	for (unsigned i = 1; i <= order / 2; i++)
-	{
-		std::pair<unsigned, unsigned> simplicial_pair = get_simplicial_pair(visited);
-		visited[simplicial_pair.first - 1] = true;
-		visited[simplicial_pair.second - 1] = true;
-
-		a[i - 1] = simplicial_pair.first;
-		b[i - 1] = simplicial_pair.second;
-		peo[2 * i - 2] = simplicial_pair.first;
-		peo[2 * i - 1] = simplicial_pair.second;
-		peo_indices[simplicial_pair.first - 1] = 2 * i - 2;
-		peo_indices[simplicial_pair.second - 1] = 2 * i - 1;
-	}
+			bool fixing = true;
+			for (unsigned i = 0; i < depth && fixing; i++)
+				fixing = automorphism->at(path->at(i)) == path->at(i);
 
-	if (order % 2 == 1)
-	{
-		unsigned x = 0;
-		for (unsigned i = 0; i < order; i++)
-		{
-			if (!visited[i])
-			{
-				x = i + 1;
-				break;
-			}
+			if (!fixing)
+				continue;
+
+			for (unsigned i = 0; i < order; i++)
+				orbits[find(i)] = find(automorphism->at(i));
 		}
 
-		peo[order - 1] = x;
-		peo_indices[x - 1] = order - 1;
-	}
+		bool equivalent = false;
+		for (unsigned i = 0; i < explored.size() && !equivalent; i++)
+			equivalent = find(explored[i]) == find(v);
 
-	for (unsigned v = 1; v <= order; v++)
-	{
-		unsigned neighbour_count = 0;
-		for (unsigned i = peo_indices[v - 1] + 1; i < order; i++)
-		{
-			if (adjacent(v, peo[i]))
-				neighbour_count++;
-		}
-		h[v - 1] = neighbour_count;
+		if (equivalent)
+			continue;
+
+		explored.push_back(v);
+
+		std::vector<uint64_t> child(*cells);
+		child[target] = cell & ~((uint64_t)1 << v);
+		child.insert(child.begin() + target, (uint64_t)1 << v);
+
+		path->push_back(v);
+		unsigned jump = search_canonical_labeling(&child, path, search);
+		path->pop_back();
+
+		if (jump < depth)
+			return jump;
 	}
 
-	delete[] visited;
+	return depth;
 }
 
 
@@ -582,7 +576,7 @@ void Graph::gen_initial_peo(unsigned * peo, unsigned * peo_indices, unsigned * h
 /**
  * constructor for given graph order and adjacency matrix
 **/
-Graph::Graph(unsigned order, unsigned * adj) {
+Graph::Graph(unsigned order, uint64_t * adj) {
 	if (order > 62)
 	{
 		RESULT("Graph has too many vertices.");
@@ -594,39 +588,39 @@ Graph::Graph(unsigned order, unsigned * adj) {
 	adj = 0;
 	size = 0;
 
-	for (unsigned v = 1; v <= order; v++)
-		for (unsigned w = v + 1; w <= order; w++)
-			if (adjacencies[get_index(v, w, order)])
-				size++;
+	for (unsigned i = 0; i < order; i++)
+		size += count_set_bits(adjacencies[i]);
+	size /= 2;
 }
 
 
 /**
  * expects a list of edges of the following form "{{1,2},{1,4},{2,3},{3,5}}"
  * changes 'this' to be the graph specified by order and edges
+ * returns false if the list is malformed, in which case 'this' is not a valid graph
 **/
-void Graph::read_graph_from_line(unsigned order, std::string * edges) {
+bool Graph::read_graph_from_line(unsigned order, std::string * edges) {
 	if (order > 62)
 	{
 		FAIL("Reading graph from line", "Graph has too many vertices.");
-		return;
+		return false;
 	}
 
-	delete[] adjacencies;
-
 	unsigned length = edges->length();
 	if (length < 2)
 	{
 		PARSE_ERROR("List of edges incomplete.");
 		FAIL("Reading graph from line", "");
-		return;
+		return false;
 	}
 
+	delete[] adjacencies;
+
 	this->order = order;
-	adjacencies = new unsigned[order * order];
+	adjacencies = new uint64_t[order];
 	size = 0;
 
-	for (unsigned i = 0; i < order * order; i++)
+	for (unsigned i = 0; i < order; i++)
 		adjacencies[i] = 0;
 
 	for (unsigned i = 1; i < length - 1;)
@@ -635,7 +629,7 @@ void Graph::read_graph_from_line(unsigned order, std::string * edges) {
 		{
 			PARSE_ERROR("Expected '{', got '" << edges->at(i) << "' instead.");
 			FAIL("Reading graph from line", "");
-			return;
+			return false;
 		}
 		i++;
 		
@@ -661,11 +655,11 @@ void Graph::read_graph_from_line(unsigned order, std::string * edges) {
 			|| second_vertex < 1 || second_vertex > order)
 		{
 			FAIL("Reading graph from line", "Illegal edge.");
-			return;
+			return false;
 		}
 
-		adjacencies[get_index(first_vertex, second_vertex, order)] = 1;
-		adjacencies[get_index(second_vertex, first_vertex, order)] = 1;
+		adjacencies[first_vertex - 1] |= get_bit(second_vertex);
+		adjacencies[second_vertex - 1] |= get_bit(first_vertex);
 		size++;
 
 		if (i >= length
@@ -674,31 +668,34 @@ void Graph::read_graph_from_line(unsigned order, std::string * edges) {
 		{
 			PARSE_ERROR("Line incomplete.");
 			FAIL("Reading graph from line", "");
-			return;
+			return false;
 		}
 		i++;
 	}
+
+	return true;
 }
 
 
 /**
  * expects a vector of edges
  * changes 'this' to be the graph specified by order and edges
+ * returns false if an edge is illegal, in which case 'this' is not a valid graph
 **/
-void Graph::read_graph_from_vector(unsigned order, std::vector<std::pair<unsigned, unsigned>> * edges) {
+bool Graph::read_graph_from_vector(unsigned order, std::vector<std::pair<unsigned, unsigned>> * edges) {
 	if (order > 62)
 	{
 		FAIL("Reading graph from vector", "Graph has too many vertices.");
-		return;
+		return false;
 	}
 
 	delete[] adjacencies;
 
 	this->order = order;
-	adjacencies = new unsigned[order * order];
+	adjacencies = new uint64_t[order];
 	size = 0;
 
-	for (unsigned i = 0; i < order * order; i++)
+	for (unsigned i = 0; i < order; i++)
 		adjacencies[i] = 0;
 
 	for (unsigned i = 0; i < edges->size(); i++)
@@ -709,13 +706,123 @@ void Graph::read_graph_from_vector(unsigned order, std::vector<std::pair<unsigne
 			|| edge.second < 1 || edge.second > order)
 		{
 			FAIL("Reading graph from vector", "Illegal edge.");
-			return;
+			return false;
 		}
 
-		adjacencies[get_index(edge.first, edge.second, order)] = 1;
-		adjacencies[get_index(edge.second, edge.first, order)] = 1;
+		adjacencies[edge.first - 1] |= get_bit(edge.second);
+		adjacencies[edge.second - 1] |= get_bit(edge.first);
 		size++;
 	}
+
+	return true;
+}
+
+
+/**
+ * expects a graph in Graph6-format given by its first length bytes, e.g., "Bw" (as stored in the g6 column of the graphs table)
+ * changes 'this' to be the graph specified by g6 by decoding its bytes directly into the adjacency rows, which are reused if the order does not change
+ * returns false without changing 'this' if g6 is incomplete or contains invalid characters
+**/
+bool Graph::read_graph_from_g6(const char * g6, unsigned length) {
+	if (length == 0)
+	{
+		PARSE_ERROR("Graph6 string is empty.");
+		FAIL("Reading graph from g6", "");
+		return false;
+	}
+
+	unsigned n = (unsigned char)g6[0] - 63;
+	if (n > 62)
+	{
+		FAIL("Reading graph from g6", "Graph has too many vertices.");
+		return false;
+	}
+
+	// the characters needed for the upper triangle have to be valid Graph6 characters, further ones are ignored
+	unsigned needed = (n * (n - 1) / 2 + 5) / 6;
+	if (length - 1 < needed)
+	{
+		PARSE_ERROR("Graph6 string incomplete.");
+		FAIL("Reading graph from g6", "");
+		return false;
+	}
+
+	for (unsigned i = 1; i <= needed; i++)
+	{
+		if ((unsigned char)g6[i] < 63
+			|| (unsigned char)g6[i] > 126)
+		{
+			PARSE_ERROR("Invalid Graph6 character '" << g6[i] << "'.");
+			FAIL("Reading graph from g6", "");
+			return false;
+		}
+	}
+
+	if (!adjacencies
+		|| order != n)
+	{
+		delete[] adjacencies;
+		adjacencies = new uint64_t[n];
+	}
+
+	this->order = n;
+	size = 0;
+
+	for (unsigned i = 0; i < order; i++)
+		adjacencies[i] = 0;
+
+	// the bit stream lists the upper triangle column by column, so column w holds the bits of the w vertex indices below w
+	// the stream is read 8 characters (48 bits) at a time into bits
+	const char * characters = g6 + 1;
+	unsigned remaining = length - 1;
+	uint64_t bits = 0;
+	unsigned number_bits = 0;
+
+	for (unsigned w = 1; w < order; w++)
+	{
+		while (number_bits < w)
+		{
+			if (remaining >= 8
+				&& number_bits <= 16)
+			{
+				bits |= unpack_g6_characters(characters) << number_bits;
+				number_bits += 48;
+				characters += 8;
+				remaining -= 8;
+			}
+			else if (remaining > 0)
+			{
+				bits |= reverse_sextets(((unsigned char)characters[0] + 1) & 0x3F) << number_bits;
+				number_bits += 6;
+				characters++;
+				remaining--;
+			}
+			else
+				number_bits = w;
+		}
+
+		uint64_t column = bits & get_low_bits(w);
+		bits >>= w;
+		number_bits -= w;
+
+		adjacencies[w] |= column;
+		size += count_set_bits(column);
+
+		for (uint64_t rest = column; rest; rest &= rest - 1)
+			adjacencies[lowest_set_bit(rest)] |= (uint64_t)1 << w;
+	}
+
+	return true;
+}
+
+
+/**
+ * expects a graph in Graph6-format, e.g., "Bw"
+ * changes 'this' to be the graph specified by g6
+ * returns false if g6 is invalid
+**/
+bool Graph::read_graph_from_g6(std::string * g6) {
+	return read_graph_from_g6(g6->c_str(), g6->length());
 }
 
 
@@ -808,95 +915,97 @@ std::string Graph::convert_to_g6_format() {
 	if (order < 63)
 		g6_string.push_back((char)order + 63);
 
-	std::vector<unsigned> bit_adjacencies = {};
+	// the columns of the upper triangle are collected in bits (the first bit of the stream being the lowest) and written 8 characters (48 bits) at a time
+	uint64_t bits = 0;
+	unsigned number_bits = 0;
 
-	for (unsigned w = order; w > 1; w--)
+	for (unsigned w = 1; w < order; w++)
 	{
-		for (unsigned v = w - 1; v > 0; v--)
-			bit_adjacencies.push_back(adjacencies[get_index(v, w, order)]);
-	}
-
-	while (!bit_adjacencies.empty())
-	{
-		unsigned byte_value = 63;
-		unsigned i;
+		uint64_t column = adjacencies[w] & get_low_bits(w);
+		unsigned column_bits = w;
 
-		for (i = 6; i > 0 && !bit_adjacencies.empty(); i--)
+		while (column_bits > 0)
 		{
-			byte_value += nth_power(2 * bit_adjacencies.back(), i - 1);
-			bit_adjacencies.pop_back();
-		}
+			unsigned taken = std::min(column_bits, 64 - number_bits);
+			bits |= (column & get_low_bits(taken)) << number_bits;
+			number_bits += taken;
+			column >>= taken;
+			column_bits -= taken;
 
-		g6_string.push_back((char)byte_value);
+			while (number_bits >= 48)
+			{
+				pack_g6_characters(bits, &g6_string);
+				bits >>= 48;
+				number_bits -= 48;
+			}
+		}
+	}
 
-		if (i > 0)
-			break;
+	for (; number_bits > 0; number_bits = number_bits > 6 ? number_bits - 6 : 0)
+	{
+		g6_string.push_back((char)(reverse_sextets(bits & 0x3F) + 63));
+		bits >>= 6;
 	}
 
 	return g6_string;
 }
 
 
+/**
+ * converts the canonical relabelling of the graph to a string using the Graph6 format
+ * isomorphic graphs have the same canonical relabelling, so the string serves as a certificate of the isomorphism class
+**/
+std::string Graph::convert_to_canonical_g6_format() {
+	if (order < 2)
+		return convert_to_g6_format();
+
+	Canonical_search search;
+	std::vector<uint64_t> cells = { get_all_bits(order) };
+	std::vector<unsigned> path;
+
+	search_canonical_labeling(&cells, &path, &search);
+
+	uint64_t * adj = new uint64_t[order];
+	for (unsigned i = 0; i < order; i++)
+		adj[i] = search.best_rows[i];
+
+	return Graph(order, adj).convert_to_g6_format();
+}
+
+
 /**
 * returns true if v and w are adjacent vertices
 **/
 bool Graph::adjacent(unsigned v, unsigned w) {
-	return adjacencies[get_index(v, w, order)] == 1;
+	return (adjacencies[v - 1] >> (w - 1)) & 1;
+}
+
+
+/**
+* returns the mask of all neighbours of given vertex (bit w-1 is set iff w is a neighbour)
+**/
+uint64_t Graph::get_neighbours(unsigned vertex) {
+	return adjacencies[vertex - 1];
 }
 
 
 /**
  * expects a file where graphs are parsed in one line in Graph6-format (e.g., a standard file generated by nauty)
- * changes 'this' to be the graph specified by read line
+ * changes 'this' to be the graph specified by read line, which is decoded in place without copying it
 **/
-bool Graph::read_next_g6_format(std::ifstream * file) {
-	std::string g6_string;
-	if (!getline(*file, g6_string) || g6_string.empty())
+bool Graph::read_next_g6_format(LineReader * file) {
+	const char * g6_string;
+	unsigned length;
+	if (!file->read_line(&g6_string, &length) || length == 0)
 		return false;
 
-	unsigned n = (unsigned)g6_string.front();
-	if (n == 126)
+	if ((unsigned char)g6_string[0] == 126)
 	{
 		FAIL("Reading g6 graph", "Graph has too many vertices.");
 		return false;
 	}
 
-	std::vector<unsigned> bit_adjacencies;
-	for (unsigned i = 1; i < g6_string.length(); i++)
-	{
-		unsigned byte_value = ((unsigned)g6_string.at(i)) - 63;
-
-		for (unsigned j = 6; j > 0; j--)
-		{
-			unsigned power = nth_power(2, j - 1);
-
-			if (power <= byte_value)
-			{
-				bit_adjacencies.push_back(1);
-				byte_value -= power;
-			}
-			else
-				bit_adjacencies.push_back(0);
-		}
-	}
-
-	std::vector<std::pair<unsigned, unsigned>> edges;
-	unsigned v = 1;
-	unsigned w = 2;
-	for (unsigned i = 0; i < bit_adjacencies.size(); i++)
-	{
-		if (bit_adjacencies.at(i) == 1)
-			edges.push_back(std::pair<unsigned, unsigned>(v, w));
-
-		v++;
-		if (v == w)
-		{
-			v = 1;
-			w++;
-		}
-	}
-
-	read_graph_from_vector(n - 63, &edges);
+	read_graph_from_g6(g6_string, length);
 
 	return true;
 }
@@ -906,9 +1015,9 @@ bool Graph::read_next_g6_format(std::ifstream * file) {
 * expects a file where graphs are parsed in one line with vertex number and edge-list, e.g., 3 {1,2},{2,3}
 * changes 'this' to be the graph specified by read line
 **/
-bool Graph::read_next_list_format(std::ifstream * file) {
+bool Graph::read_next_list_format(LineReader * file) {
 	std::string line = "";
-	while (getline(*file, line) && line.empty());
+	while (file->read_line(&line) && line.empty());
 
 	if (line.empty())
 		return false;
@@ -996,58 +1105,51 @@ bool Graph::read_next_list_format(std::ifstream * file) {
  * returns the edgewise complement of the graph
 **/
 Graph Graph::get_complement() {
-	unsigned * adj = new unsigned[order * order];
+	uint64_t * adj = new uint64_t[order];
 
 	for (unsigned v = 1; v <= order; v++)
-	{
-		for (unsigned w = v + 1; w <= order; w++)
-		{
-			unsigned i = get_index(v, w, order);
-			unsigned j = get_index(w, v, order);
-
-			adj[i] = 1 - adjacencies[i];
-			adj[j] = 1 - adjacencies[j];
-		}
-	}
+		adj[v - 1] = ~adjacencies[v - 1] & get_all_bits(order) & ~get_bit(v);
 	
 	return Graph(order, adj);
 }
 
 
 /**
-* returns the clique number and the number of inclusion-maximal cliques
+* returns the clique number and the number of inclusion-maximal cliques, read off the cotree for cographs and via Bron-Kerbosch otherwise
 **/
 std::vector<unsigned> Graph::get_clique_numbers() {
-	std::vector<std::vector<unsigned>> max_cliques;
-	std::vector<unsigned> include_all;
-	std::vector<unsigned> include_some;
-	std::vector<unsigned> include_none;
-	for (unsigned v = 1; v <= order; v++)
-		include_some.push_back(v);
+	Cotree cotree;
+	if (gen_cotree(&cotree))
+		return cotree.get_clique_numbers();
 
-	unsigned clique_number = bron_kerbosch_pivot(&max_cliques, 0, &include_all, &include_some, &include_none);
+	unsigned clique_number = 0;
+	unsigned max_cliques = 0;
 
-	return { clique_number, (unsigned)max_cliques.size() };
+	bron_kerbosch_pivot(adjacencies, 0, get_all_bits(order), 0, &clique_number, &max_cliques);
+
+	return { clique_number, max_cliques };
 }
 
 
 /**
- * returns the detour number, i.e., the length of the longest induce path by iterating over all vertex subsets
- * this is done by taking advantage of the binary representation of integers (e.g., for order n=5: 6 = 1010 = {2,4})
+ * returns the detour number, i.e., the length of the longest induced path, via branch and bound over induced paths grown from every start vertex
+ * no induced path can be longer than the largest connected component allows, so the search stops once such a path is found
 **/
 std::vector<unsigned> Graph::get_detour_number() {
-	unsigned pow_set_size = nth_power(2, order);
 	unsigned max_detour = 0;
+	unsigned bound = 0;
 
-	for (int subset = pow_set_size - 1; subset > 0; subset--)
+	for (uint64_t rest = get_all_bits(order); rest; )
 	{
-		unsigned subset_order = count_set_bits(subset);
-
-		if (max_detour < subset_order - 1
-			&& is_induced_path(subset, subset_order))
-			max_detour = subset_order - 1;
+		uint64_t component = get_reachable(lowest_set_bit(rest) + 1, get_all_bits(order));
+		if (bound < count_set_bits(component) - 1)
+			bound = count_set_bits(component) - 1;
+		rest &= ~component;
 	}
 
+	for (unsigned v = 1; v <= order && max_detour < bound; v++)
+		extend_induced_path(v, 0, get_bit(v), bound, &max_detour);
+
 	return { max_detour };
 }
 
@@ -1061,10 +1163,7 @@ std::vector<unsigned> Graph::get_extreme_degrees() {
 
 	for (unsigned v = 1; v <= order; v++)
 	{
-		unsigned degree = 0;
-		
-		for (unsigned w = 1; w <= order; w++)
-			degree += adjacencies[get_index(v, w, order)];
+		unsigned degree = count_set_bits(adjacencies[v - 1]);
 
 		if (degree > max_deg)
 			max_deg = degree;
@@ -1077,79 +1176,90 @@ std::vector<unsigned> Graph::get_extreme_degrees() {
 
 
 /**
-* returns the independence number and the number of inclusion-maximal independent sets via respective clique numbers in the complement graph
+* returns the independence number and the number of inclusion-maximal independent sets, read off the cotree for cographs
+* and otherwise via respective clique numbers in the complement graph, which is only built as neighbour masks on the stack
 **/
 std::vector<unsigned> Graph::get_independence_numbers() {
-	Graph complement = get_complement();
-	return complement.get_clique_numbers();
+	Cotree cotree;
+	if (gen_cotree(&cotree))
+		return cotree.get_independence_numbers();
+
+	uint64_t complement[62];
+
+	for (unsigned v = 1; v <= order; v++)
+		complement[v - 1] = ~adjacencies[v - 1] & get_all_bits(order) & ~get_bit(v);
+
+	unsigned independence_number = 0;
+	unsigned max_independent_sets = 0;
+
+	bron_kerbosch_pivot(complement, 0, get_all_bits(order), 0, &independence_number, &max_independent_sets);
+
+	return { independence_number, max_independent_sets };
 }
 
 
 /**
  * returns the girth of the graph, i.e., the minimum length of a cycle (0 if there are none), via modified breadth-first-search
+ * graphs of order up to FIXED_MAX_ORDER are handled by the kernel of FixedGraph compiled for their order
 **/
 std::vector<unsigned> Graph::get_girth() {
+	if (order >= 1
+		&& order <= FIXED_MAX_ORDER)
+		return { Fixed_kernels::get(order).get_girth(adjacencies) };
+
 	unsigned girth = order + 1;
-	bool * visited = new bool[order];
 	unsigned * parent = new unsigned[order];
 	unsigned * distance = new unsigned[order];
+	std::vector<unsigned> queue;
 
 	for (unsigned v = 1; v <= order; v++)
 	{
-		std::vector<unsigned> queue;
+		if (count_set_bits(adjacencies[v - 1]) < 2)
+			continue;
+
+		uint64_t visited = get_bit(v);
+		queue.clear();
 
-		for (unsigned neighbor = 1; neighbor <= order; neighbor++)
+		for (unsigned i = 0; i < order; i++)
 		{
-			if (neighbor == v)
-			{
-				visited[neighbor - 1] = true;
-				parent[neighbor - 1] = 0;
-				distance[neighbor - 1] = 0;
-			}
-			else if (adjacent(v, neighbor))
-			{
-				visited[neighbor - 1] = false;
-				parent[neighbor - 1] = v;
-				distance[neighbor - 1] = 1;
-				queue.push_back(neighbor);
-			}
-			else
-			{
-				visited[neighbor - 1] = false;
-				parent[neighbor - 1] = 0;
-				distance[neighbor - 1] = order + 1;
-			}
+			parent[i] = 0;
+			distance[i] = order + 1;
 		}
+		distance[v - 1] = 0;
 
-		if (queue.size() < 2)
-			continue;
+		for (uint64_t rest = adjacencies[v - 1]; rest; rest &= rest - 1)
+		{
+			unsigned neighbor = lowest_set_bit(rest) + 1;
+			parent[neighbor - 1] = v;
+			distance[neighbor - 1] = 1;
+			queue.push_back(neighbor);
+		}
 
-		while (!queue.empty())
+		for (unsigned front = 0; front < queue.size(); front++)
 		{
-			unsigned current = queue.front();
-			queue.erase(queue.begin());
-			visited[current - 1] = true;
+			unsigned current = queue[front];
+			visited |= get_bit(current);
 
-			for (unsigned neighbor = 1; neighbor <= order; neighbor++)
+			uint64_t neighbors = adjacencies[current - 1];
+			if (parent[current - 1] != 0)
+				neighbors &= ~get_bit(parent[current - 1]);
+
+			for (uint64_t rest = neighbors; rest; rest &= rest - 1)
 			{
-				if (neighbor != current
-					&& adjacent(current, neighbor)
-					&& neighbor != parent[current - 1])
+				unsigned neighbor = lowest_set_bit(rest) + 1;
+
+				if (!(visited & get_bit(neighbor)))
 				{
-					if (!visited[neighbor - 1])
-					{
-						parent[neighbor - 1] = current;
-						distance[neighbor - 1] = distance[current - 1] + 1;
-						queue.push_back(neighbor);
-					}
-					else if (girth > distance[neighbor - 1] + distance[current - 1] + 1)
-						girth = distance[neighbor - 1] + distance[current - 1] + 1;
+					parent[neighbor - 1] = current;
+					distance[neighbor - 1] = distance[current - 1] + 1;
+					queue.push_back(neighbor);
 				}
+				else if (girth > distance[neighbor - 1] + distance[current - 1] + 1)
+					girth = distance[neighbor - 1] + distance[current - 1] + 1;
 			}
 		}
 	}
 
-	delete[] visited;
 	delete[] parent;
 	delete[] distance;
 
@@ -1159,6 +1269,18 @@ std::vector<unsigned> Graph::get_girth() {
 }
 
 
+/**
+ * changes cotree to be the cotree of the graph, i.e., the decomposition of the graph by disjoint unions and joins down to its vertices (if cotree is not 0)
+ * returns false if the graph is no cograph, in which case cotree is incomplete
+**/
+bool Graph::gen_cotree(Cotree * cotree) {
+	if (order == 0)
+		return true;
+
+	return build_cotree(cotree, get_all_bits(order), -1);
+}
+
+
 /**
 * tests if the graph is closed with respect to the labeling induced by given (perfect elimination) ordering, i.e.
 * {a,b},{i,j} in E(G) with a < b, i < j  =>  {a,i} in E(G) if b=j and {b,j} in E(G) if a=i
@@ -1209,36 +1331,15 @@ bool Graph::is_closed_wrt_labeling(unsigned * peo, unsigned * peo_indices) {
  * tests if the graph is connected
 **/
 bool Graph::is_connected() {
-	unsigned * vertices = new unsigned[order];
-	for (unsigned i = 0; i < order; i++)
-		vertices[i] = i + 1;
-
-	bool connected = is_induced_connected(vertices, order);
-
-	delete[] vertices;
-	return connected;
+	return is_induced_connected(get_all_bits(order));
 }
 
 
 /**
- * tests if the graph is a cograph, i.e. it has no induced path of length 3
+ * tests if the graph is a cograph, i.e. it has no induced path of length 3, by trying to decompose it into a cotree
 **/
 bool Graph::is_cograph() {
-	if (order < 4)
-		return true;
-
-	unsigned pow_set_size = nth_power(2, order);
-
-	for (int subset = pow_set_size - 1; subset >= 15; subset--)
-	{
-		unsigned subset_order = count_set_bits(subset);
-
-		if (subset_order == 4
-			&& is_induced_path(subset, 4))
-			return false;
-	}
-
-	return true;
+	return gen_cotree(0);
 }
 
 
@@ -1246,47 +1347,27 @@ bool Graph::is_cograph() {
  * tests if the graph is euler, i.e. it has no vertices of odd degree
 **/
 bool Graph::is_euler() {
-	if (order < 1)
-		return true;
-
-	unsigned * degrees = new unsigned[order];
-
 	for (unsigned i = 0; i < order; i++)
-		degrees[i] = 0;
-
-	for (unsigned first_vertex = 1; first_vertex <= order; first_vertex++)
 	{
-		for (unsigned second_vertex = first_vertex + 1; second_vertex <= order; second_vertex++)
-		{
-			if (adjacent(first_vertex, second_vertex))
-			{
-				degrees[first_vertex - 1]++;
-				degrees[second_vertex - 1]++;
-			}
-		}
-	}
-
-	for (unsigned i = 0; i < order; i++)
-	{
-		if (degrees[i] % 2 == 1)
-		{
-			delete[] degrees;
+		if (count_set_bits(adjacencies[i]) % 2 == 1)
 			return false;
-		}
 	}
 
-	delete[] degrees;
 	return true;
 }
 
 
 /**
  * tests if the graph is chordal, i.e. its vertices have a perfect elimination ordering
+ * graphs of order up to FIXED_MAX_ORDER are handled by the kernel of FixedGraph compiled for their order
 **/
 bool Graph::is_chordal() {
 	if (order < 4)
 		return true;
 
+	if (order <= FIXED_MAX_ORDER)
+		return Fixed_kernels::get(order).is_chordal(adjacencies);
+
 	std::pair<unsigned *, unsigned *> ordering = gen_lexicographic_ordering();
 
 	for (unsigned v = 1; v <= order; v++)
@@ -1322,20 +1403,28 @@ bool Graph::is_chordal() {
 
 /**
  * tests if the graph is claw-free, i.e. it has no complete 1-3-bipartite induced subgraph
+ * this is done by searching the neighbourhood of each vertex for three pairwise non-adjacent vertices
 **/
 bool Graph::is_clawfree() {
-	if (order < 4)
-		return true;
+	for (unsigned v = 0; v < order; v++)
+	{
+		uint64_t neighbours = adjacencies[v];
+		if (count_set_bits(neighbours) < 3)
+			continue;
 
-	unsigned pow_set_size = nth_power(2, order);
+		for (uint64_t rest = neighbours; rest; rest &= rest - 1)
+		{
+			unsigned a = lowest_set_bit(rest);
+			uint64_t candidates = rest & (rest - 1) & ~adjacencies[a];
 
-	for (int subset = pow_set_size - 1; subset >= 15; subset--)
-	{
-		unsigned subset_order = count_set_bits(subset);
+			for (uint64_t rest_b = candidates; rest_b; rest_b &= rest_b - 1)
+			{
+				unsigned b = lowest_set_bit(rest_b);
 
-		if (subset_order == 4
-			&& is_induced_claw(subset))
-			return false;
+				if (rest_b & (rest_b - 1) & ~adjacencies[b])
+					return false;
+			}
+		}
 	}
 
 	return true;
@@ -1343,38 +1432,21 @@ bool Graph::is_clawfree() {
 
 
 /**
- * expects the graph to be chordal
  * tests if the graph is closed, i.e. there exists an labeling with respect to which the graph is closed
+ * closed graphs are exactly the proper interval graphs, which are recognized via LexBFS+
+ * graphs of order up to FIXED_MAX_ORDER are handled by the kernel of FixedGraph compiled for their order
 **/
 bool Graph::is_closed() {
 	if (order < 3)
 		return true;
 
-	bool closed = false;
-	unsigned * peo = new unsigned[order];
-	unsigned * peo_indices = new unsigned[order];
-	unsigned * h = new unsigned[order];
-	unsigned * a = new unsigned[order / 2];
-	unsigned * b = new unsigned[order / 2];
-
-	gen_initial_peo(peo, peo_indices, h, a, b);
-	closed = is_closed_wrt_labeling(peo, peo_indices);
-
-	if (!closed)
-		closed = test_pe_orderings(peo, peo_indices, h, a, b, order / 2);
-
-	if (!closed)
-		closed = peo_switch(peo, peo_indices, h, a, b, order / 2 - 1);
-
-	if (!closed)
-		closed = test_pe_orderings(peo, peo_indices, h, a, b, order / 2);
+	if (order <= FIXED_MAX_ORDER)
+		return Fixed_kernels::get(order).is_closed(adjacencies);
 
-	delete[] peo;
-	delete[] peo_indices;
-	delete[] h;
-	delete[] a;
-	delete[] b;
+	unsigned * ordering = new unsigned[order];
+	bool closed = gen_proper_interval_ordering(ordering);
 
+	delete[] ordering;
 	return closed;
 }
 
@@ -1394,48 +1466,14 @@ bool Graph::is_cone() {
 
 /**
  * expects the graph to be closed
- * returns an ordering inducing a labeling with respect to which the graph is closed
+ * returns an ordering inducing a labeling with respect to which the graph is closed, i.e., a proper interval ordering
 **/
 unsigned * Graph::gen_closed_ordering() {
 	if (order < 1)
 		return 0;
 
-	unsigned * peo = new unsigned[order];
-
-	if (order == 1)
-	{
-		peo[0] = 1;
-		return peo;
-	}
-
-	if (order == 2)
-	{
-		peo[0] = 1;
-		peo[1] = 2;
-		return peo;
-	}
-
-	unsigned * peo_indices = new unsigned[order];
-	bool closed = false;
-	unsigned * h = new unsigned[order];
-	unsigned * a = new unsigned[order / 2];
-	unsigned * b = new unsigned[order / 2];
-
-	gen_initial_peo(peo, peo_indices, h, a, b);
-	closed = is_closed_wrt_labeling(peo, peo_indices);
-
-	if (!closed)
-		closed = test_pe_orderings(peo, peo_indices, h, a, b, order / 2);
-
-	if (!closed)
-		closed = peo_switch(peo, peo_indices, h, a, b, order / 2 - 1);
-
-	if (!closed)
-		test_pe_orderings(peo, peo_indices, h, a, b, order / 2);
+	unsigned * ordering = new unsigned[order];
+	gen_proper_interval_ordering(ordering);
 
-	delete[] h;
-	delete[] a;
-	delete[] b;
-	delete[] peo_indices;
-	return peo;
+	return ordering;
 }
@@ -0,0 +1,293 @@
+#include "GraphBatch.h"
+
+
+//########## helper functions ##########
+/**
+ * returns the mask of the graphs whose bit-sliced number a is greater than their bit-sliced number b
+**/
+inline uint64_t sliced_greater(const uint64_t * a, const uint64_t * b) {
+	uint64_t greater = 0;
+	uint64_t equal = ~(uint64_t)0;
+
+	for (unsigned i = DEGREE_BITS; i > 0; i--)
+	{
+		greater |= equal & a[i - 1] & ~b[i - 1];
+		equal &= ~(a[i - 1] ^ b[i - 1]);
+	}
+
+	return greater;
+}
+
+
+/**
+ * changes the bit-sliced number target to source in the graphs of mask
+**/
+inline void sliced_assign(uint64_t * target, const uint64_t * source, uint64_t mask) {
+	for (unsigned i = 0; i < DEGREE_BITS; i++)
+		target[i] = (source[i] & mask) | (target[i] & ~mask);
+}
+
+
+/**
+ * returns the number of the graph with given index in a bit-sliced number
+**/
+inline unsigned sliced_value(const uint64_t * number, unsigned index) {
+	unsigned value = 0;
+
+	for (unsigned i = 0; i < DEGREE_BITS; i++)
+		value |= (unsigned)((number[i] >> index) & 1) << i;
+
+	return value;
+}
+
+
+//########## private member functions ##########
+/**
+ * returns the mask of all graphs added to the batch
+**/
+uint64_t GraphBatch::get_used() {
+	return count == BATCH_SIZE ? ~(uint64_t)0 : ((uint64_t)1 << count) - 1;
+}
+
+
+/**
+ * changes degree to the bit-sliced degree of the vertex with index v in every graph, adding up its planes with a ripple-carry counter
+**/
+void GraphBatch::count_degree(unsigned v, uint64_t * degree) {
+	for (unsigned i = 0; i < DEGREE_BITS; i++)
+		degree[i] = 0;
+
+	for (unsigned w = 0; w < order; w++)
+	{
+		uint64_t carry = plane(v, w);
+
+		for (unsigned i = 0; i < DEGREE_BITS && carry; i++)
+		{
+			uint64_t next = degree[i] & carry;
+			degree[i] ^= carry;
+			carry = next;
+		}
+	}
+}
+
+
+//########## public member functions ##########
+/**
+ * returns the order of all graphs of the batch
+**/
+unsigned GraphBatch::get_order() {
+	return order;
+}
+
+
+/**
+ * returns the number of graphs added to the batch
+**/
+unsigned GraphBatch::get_count() {
+	return count;
+}
+
+
+/**
+ * adds g as the next graph of the batch
+ * returns false if the batch is full or g is of another order
+**/
+bool GraphBatch::add_graph(Graph * g) {
+	if (count == BATCH_SIZE
+		|| g->get_order() != order)
+		return false;
+
+	uint64_t bit = (uint64_t)1 << count;
+
+	for (unsigned v = 0; v < order; v++)
+	{
+		for (uint64_t rest = g->get_neighbours(v + 1); rest; rest &= rest - 1)
+			plane(v, lowest_set_bit(rest)) |= bit;
+	}
+
+	count++;
+	return true;
+}
+
+
+/**
+ * adds the graph given by its Graph6 bytes as the next graph of the batch without decoding it into a Graph
+ * returns false if the batch is full, the graph is of another order or its Graph6 is incomplete or invalid
+**/
+bool GraphBatch::add_graph_from_g6(const char * g6, unsigned length) {
+	if (count == BATCH_SIZE
+		|| length == 0
+		|| (unsigned)((unsigned char)g6[0] - 63) != order
+		|| length < 1 + (g6_positions.size() + 5) / 6)
+		return false;
+
+	for (unsigned i = 1; i < 1 + (g6_positions.size() + 5) / 6; i++)
+	{
+		if ((unsigned char)g6[i] < 63
+			|| (unsigned char)g6[i] > 126)
+			return false;
+	}
+
+	uint64_t bit = (uint64_t)1 << count;
+
+	// only the set bits of each byte are visited
+	for (unsigned i = 1; i < length && 6 * (i - 1) < g6_positions.size(); i++)
+	{
+		unsigned byte_value = (unsigned char)g6[i] - 63;
+
+		for (uint64_t rest = byte_value & 63; rest; rest &= rest - 1)
+		{
+			unsigned position = 6 * (i - 1) + 5 - lowest_set_bit(rest);
+			if (position >= g6_positions.size())
+				continue;
+
+			plane(g6_positions[position].first, g6_positions[position].second) |= bit;
+			plane(g6_positions[position].second, g6_positions[position].first) |= bit;
+		}
+	}
+
+	count++;
+	return true;
+}
+
+
+/**
+ * returns the minimum and maximum degree of vertices of every graph, keeping bit-sliced running extremes over the vertices
+**/
+std::vector<std::vector<unsigned>> GraphBatch::get_extreme_degrees() {
+	if (order == 0)
+		return std::vector<std::vector<unsigned>>(count, { order - 1, 0 });
+
+	uint64_t minimum[DEGREE_BITS];
+	uint64_t maximum[DEGREE_BITS];
+	uint64_t degree[DEGREE_BITS];
+
+	for (unsigned i = 0; i < DEGREE_BITS; i++)
+	{
+		minimum[i] = ((order - 1) >> i) & 1 ? ~(uint64_t)0 : 0;
+		maximum[i] = 0;
+	}
+
+	for (unsigned v = 0; v < order; v++)
+	{
+		count_degree(v, degree);
+		sliced_assign(maximum, degree, sliced_greater(degree, maximum));
+		sliced_assign(minimum, degree, sliced_greater(minimum, degree));
+	}
+
+	std::vector<std::vector<unsigned>> degrees;
+	degrees.reserve(count);
+
+	for (unsigned k = 0; k < count; k++)
+		degrees.push_back({ sliced_value(minimum, k), sliced_value(maximum, k) });
+
+	return degrees;
+}
+
+
+/**
+ * tests which graphs are connected by a breadth-first search from the first vertex in all graphs at once
+**/
+uint64_t GraphBatch::is_connected() {
+	if (order < 2)
+		return get_used();
+
+	std::vector<uint64_t> reached(order, 0);
+	reached[0] = ~(uint64_t)0;
+
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+
+		for (unsigned w = 1; w < order; w++)
+		{
+			uint64_t reach = reached[w];
+			for (unsigned v = 0; v < order; v++)
+				reach |= reached[v] & plane(v, w);
+
+			if (reach != reached[w])
+			{
+				reached[w] = reach;
+				changed = true;
+			}
+		}
+	}
+
+	uint64_t connected = get_used();
+	for (unsigned w = 1; w < order; w++)
+		connected &= reached[w];
+
+	return connected;
+}
+
+
+/**
+ * tests which graphs are euler, i.e., have no vertices of odd degree, by the parities of the degrees
+**/
+uint64_t GraphBatch::is_euler() {
+	uint64_t odd = 0;
+
+	for (unsigned v = 0; v < order; v++)
+	{
+		uint64_t parity = 0;
+		for (unsigned w = 0; w < order; w++)
+			parity ^= plane(v, w);
+
+		odd |= parity;
+	}
+
+	return get_used() & ~odd;
+}
+
+
+/**
+ * tests which graphs are claw-free by searching the neighbourhood of each vertex for three pairwise non-adjacent vertices in all graphs at once
+**/
+uint64_t GraphBatch::is_clawfree() {
+	uint64_t claw = 0;
+
+	for (unsigned v = 0; v < order; v++)
+	{
+		for (unsigned a = 0; a < order; a++)
+		{
+			uint64_t with_a = plane(v, a);
+			if (!with_a)
+				continue;
+
+			for (unsigned b = a + 1; b < order; b++)
+			{
+				uint64_t with_b = with_a & plane(v, b) & ~plane(a, b);
+				if (!with_b)
+					continue;
+
+				for (unsigned c = b + 1; c < order; c++)
+					claw |= with_b & plane(v, c) & ~plane(a, c) & ~plane(b, c);
+			}
+		}
+	}
+
+	return get_used() & ~claw;
+}
+
+
+/**
+ * tests which graphs are cones, i.e., have a universal vertex
+**/
+uint64_t GraphBatch::is_cone() {
+	uint64_t cone = 0;
+
+	for (unsigned v = 0; v < order; v++)
+	{
+		uint64_t universal = ~(uint64_t)0;
+		for (unsigned w = 0; w < order; w++)
+		{
+			if (w != v)
+				universal &= plane(v, w);
+		}
+
+		cone |= universal;
+	}
+
+	return get_used() & cone;
+}
@@ -0,0 +1,228 @@
+#include "LineReader.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
+
+
+//########## private member functions ##########
+/**
+ * moves the unread rest of the buffer to its front (growing the buffer if the rest fills it) and appends the next block of the stream
+ * returns false if nothing could be read anymore
+**/
+bool LineReader::fill_buffer() {
+	if (!stream
+		|| feof(stream)
+		|| ferror(stream))
+		return false;
+
+	if (position > length)
+		position = length;
+
+	size_t rest = length - position;
+	if (rest > 0
+		&& position > 0)
+		memmove(&buffer[0], &buffer[position], rest);
+	position = 0;
+	length = rest;
+
+	if (length == buffer.size())
+		buffer.resize(2 * buffer.size());
+
+	size_t read = fread(&buffer[length], 1, buffer.size() - length, stream);
+	length += read;
+	data = &buffer[0];
+
+	return read > 0;
+}
+
+
+//########## public member functions ##########
+/**
+ * opens and maps the file with given name, an empty file is open but has no lines
+**/
+LineReader::LineReader(const char * filename) : data(0), length(0), position(0), open(false), stream(0), process(false), buffer{} {
+#ifdef _WIN32
+	mapping_handle = 0;
+	file_handle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	if (file_handle == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file_handle, &file_size))
+		return;
+
+	length = (size_t)file_size.QuadPart;
+	open = true;
+
+	if (length == 0)
+		return;
+
+	mapping_handle = CreateFileMappingA(file_handle, 0, PAGE_READONLY, 0, 0, 0);
+	if (mapping_handle)
+		data = (const char *)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+#else
+	descriptor = ::open(filename, O_RDONLY);
+	if (descriptor == -1)
+		return;
+
+	struct stat file_status;
+	if (fstat(descriptor, &file_status) == -1)
+		return;
+
+	length = (size_t)file_status.st_size;
+	open = true;
+
+	if (length == 0)
+		return;
+
+	void * mapping = mmap(0, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	if (mapping != MAP_FAILED)
+	{
+		data = (const char *)mapping;
+		madvise(mapping, length, MADV_SEQUENTIAL);
+	}
+#endif
+
+	if (!data)
+	{
+		length = 0;
+		open = false;
+	}
+}
+
+
+/**
+ * reads the lines of given stream, which is the pipe of a child process (closed with pclose) if process is set
+ * the stream is consumed only as fast as lines are read, so a writing child process is held back by the pipe meanwhile
+**/
+LineReader::LineReader(FILE * stream, bool process) : data(0), length(0), position(0), open(stream != 0), stream(stream), process(process), buffer(STREAM_BUFFER_SIZE) {
+#ifdef _WIN32
+	file_handle = INVALID_HANDLE_VALUE;
+	mapping_handle = 0;
+#else
+	descriptor = -1;
+#endif
+	data = &buffer[0];
+}
+
+
+/**
+ * unmaps and closes the file or closes the pipe of the child process (other streams are left open for further use)
+**/
+LineReader::~LineReader() {
+	if (!buffer.empty())
+	{
+		close();
+		return;
+	}
+
+#ifdef _WIN32
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping_handle)
+		CloseHandle(mapping_handle);
+	if (file_handle != INVALID_HANDLE_VALUE)
+		CloseHandle(file_handle);
+#else
+	if (data)
+		munmap((void *)data, length);
+	if (descriptor != -1)
+		::close(descriptor);
+#endif
+}
+
+
+/**
+ * returns true if the file could be opened and mapped
+**/
+bool LineReader::is_open() {
+	return open;
+}
+
+
+/**
+ * stops reading a stream, closing the pipe of the child process (other streams are left open for further use)
+ * returns the exit status of the child process, or 0 for other streams and files (which are closed by the destructor)
+**/
+int LineReader::close() {
+	int status = 0;
+
+	if (stream)
+	{
+		if (process)
+		{
+#ifdef _WIN32
+			status = _pclose(stream);
+#else
+			status = pclose(stream);
+			if (status != -1
+				&& WIFEXITED(status))
+				status = WEXITSTATUS(status);
+#endif
+		}
+		else
+			clearerr(stream);
+
+		stream = 0;
+		open = false;
+		length = 0;
+		position = 0;
+	}
+
+	return status;
+}
+
+
+/**
+ * changes line to point to the next line within the mapping or buffer (valid until the next call) and line_length to its length (without line break)
+ * returns false if there are no lines left
+**/
+bool LineReader::read_line(const char ** line, unsigned * line_length) {
+	const char * end = position < length ? (const char *)memchr(data + position, '\n', length - position) : 0;
+
+	while (!end
+		&& fill_buffer())
+		end = (const char *)memchr(data + position, '\n', length - position);
+
+	if (position >= length)
+		return false;
+
+	const char * start = data + position;
+	if (!end)
+		end = data + length;
+
+	position = end - data + 1;
+
+	if (end > start && *(end - 1) == '\r')
+		end--;
+
+	*line = start;
+	*line_length = end - start;
+
+	return true;
+}
+
+
+/**
+ * changes line to a copy of the next line (without line break)
+ * returns false if there are no lines left
+**/
+bool LineReader::read_line(std::string * line) {
+	const char * start;
+	unsigned line_length;
+
+	if (!read_line(&start, &line_length))
+		return false;
+
+	line->assign(start, line_length);
+	return true;
+}
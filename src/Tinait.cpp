@@ -6,10 +6,10 @@
 
 
 const std::string vocabulary[] = {
-    "exit", "quit", "help", "sql", "import", "compute", "classify", "scripts", "results", "show", "save",
-    "select", "distinct", "from", "where", "group by", "order by", "desc", "asc", "limit", "and", "case", "when", "then", "else", "end", "max", "count", "sum", "like", "not", "null", "is null", "union", "inner join",
-    "graphs", "graphid", "graphorder", "graphsize", "edges", "type", "cliquenr", "maxcliques", "independencenr", "maxindependentsets", "detournr", "mindeg", "maxdeg", "girth", "connected", "cograph", "euler", "chordal", "claw-free", "closed", "cone",
-    "-g6", "-list", "-clique", "-independence", "-detour", "-degree", "-girth", "-where", "-allexcept", "-connected", "-cograph", "-euler", "-chordal", "-claw-free", "-closed", "-cone", "-betti", "-hpoldeg", "bei", "initBei", "clInitBei", "pbei", "initPbei"
+    "exit", "quit", "help", "sql", "import", "compute", "classify", "scripts", "results", "run", "resume", "show", "save",
+    "select", "distinct", "from", "where", "group by", "order by", "desc", "asc", "limit", "and", "case", "when", "then", "else", "end", "max", "count", "sum", "like", "not", "null", "is null", "union", "inner join", "create virtual table", "using", "g6file",
+    "graphs", "graphid", "is_cograph", "is_chordal", "is_clawfree", "is_closed", "graphorder", "graphsize", "edges", "g6", "canonical", "typemask", "testedmask", "cliquenr", "maxcliques", "independencenr", "maxindependentsets", "detournr", "mindeg", "maxdeg", "girth", "connected", "cograph", "euler", "chordal", "clawfree", "closed", "cone",
+    "-g6", "-list", "-compact", "-dedupe", "-batch", "-cmd", "-processes", "-retries", "-balance", "-cost", "-clique", "-independence", "-detour", "-degree", "-girth", "-where", "-threads", "-index", "-allexcept", "-connected", "-cograph", "-euler", "-chordal", "-claw-free", "-closed", "-cone", "-betti", "-hpoldeg", "bei", "initBei", "clInitBei", "pbei", "initPbei"
 };
 
 
@@ -96,6 +96,10 @@ int io_interface(DatabaseInterface * dbi) {
 		classify_parse(dbi, &input);
 	else if (keyword == "results")
 		results_parse(dbi, &input);
+	else if (keyword == "run")
+		run_parse(dbi, &input);
+	else if (keyword == "resume")
+		resume_parse(dbi, &input);
 	else if (keyword == "scripts")
 		script_parse(dbi, &input);
 	else if (keyword == "compute")
@@ -113,7 +117,7 @@ int io_interface(DatabaseInterface * dbi) {
 //########## main function ##########
 /**
  * opens the given database (if none is specified it opens 'Graphs.db'),
- * creates scripts and graphs table, if they do not exist
+ * creates scripts, graphs and jobs table, if they do not exist
  * prints help text and calls io_interface
 **/
 int main(int argc, char * argv[]) {
@@ -129,8 +133,12 @@ int main(int argc, char * argv[]) {
 	else
 		dbi = DatabaseInterface("Graphs.db");
 
+	std::vector<const char *> types = get_types();
+
 	dbi.create_scripts_table();
-	dbi.create_graphs_table();
+	dbi.create_graphs_table(&types);
+	dbi.create_jobs_table();
+	register_graph_functions(&dbi);
 	rl_attempted_completion_function = dbi_completion;
 
 	std::string temp = "";
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+
+/**
+* bounded queue handing work between threads
+* push blocks while the queue is full, pop blocks while it is empty and returns false once the queue is closed and drained
+**/
+template <typename T>
+class WorkQueue
+{
+private:
+	std::deque<T> items;
+	size_t capacity;
+	bool closed;
+
+	std::mutex mutex;
+	std::condition_variable not_empty;
+	std::condition_variable not_full;
+
+public:
+	WorkQueue(size_t capacity) : items{}, capacity(capacity), closed(false) {}
+
+
+	/**
+	* appends item to the queue, returns false if the queue has been closed in the meantime
+	**/
+	bool push(T && item) {
+		std::unique_lock<std::mutex> lock(mutex);
+		not_full.wait(lock, [this] { return closed || items.size() < capacity; });
+
+		if (closed)
+			return false;
+
+		items.push_back(std::move(item));
+		not_empty.notify_one();
+		return true;
+	}
+
+
+	/**
+	* changes item to be the first item of the queue and removes it, returns false if the queue is closed and empty
+	**/
+	bool pop(T * item) {
+		std::unique_lock<std::mutex> lock(mutex);
+		not_empty.wait(lock, [this] { return closed || !items.empty(); });
+
+		if (items.empty())
+			return false;
+
+		*item = std::move(items.front());
+		items.pop_front();
+		not_full.notify_one();
+		return true;
+	}
+
+
+	/**
+	* closes the queue, remaining items can still be popped
+	**/
+	void close() {
+		std::lock_guard<std::mutex> lock(mutex);
+		closed = true;
+		not_empty.notify_all();
+		not_full.notify_all();
+	}
+
+
+	/**
+	* closes the queue and drops all remaining items
+	**/
+	void cancel() {
+		std::lock_guard<std::mutex> lock(mutex);
+		items.clear();
+		closed = true;
+		not_empty.notify_all();
+		not_full.notify_all();
+	}
+};
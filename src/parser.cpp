@@ -1,5 +1,7 @@
 #include "parser.h"
 
+#include <thread>
+
 
 #define help_text	"Tinait - Graphs database interface\n" \
 					"Enter 'help' to see this text.\n" \
@@ -24,10 +26,14 @@
 					"     classify : shows a description of the 'classify' functionality\n" \
 					"     scripts  : shows a description of the 'scripts' functionality\n" \
 					"     results  : shows a description of the 'results' functionality\n" \
+					"     run      : shows a description of the 'run' functionality\n" \
+					"     resume   : shows a description of the 'resume' functionality\n" \
 					"     show     : shows a description of the 'show' functionality\n" \
 					"     save     : shows a description of the 'save' functionality\n" \
 					"\n" \
-					"Every input not starting with a keyword will be interpreted as an SQL query. Results from queries will be saved in memory as the current view.\n"
+					"Every input not starting with a keyword will be interpreted as an SQL query. Results from queries become the current view.\n" \
+					"Only its first 1000 rows are kept in memory, further rows are read from the database again whenever the view is shown or saved.\n" \
+					"Once the database has changed (e.g., by compute or classify), only these 1000 rows can be shown or saved, so execute the query again to read all of its rows.\n"
 
 
 #define sql_text	"Some SQL queries (note that sqlite is not case-sensitive, but this program only accepts 'SELECT', 'Select' and 'select' for queries):\n" \
@@ -37,30 +43,30 @@
 					"SELECT DISTINCT graphOrder FROM Graphs WHERE graphSize == 4;\n" \
 					"SELECT graphSize FROM Graphs ORDER BY graphSize DESC LIMIT 5;\n" \
 					"SELECT MAX(graphSize) FROM Graphs;\n" \
-					"SELECT graphOrder, count(*) FROM Graphs WHERE type LIKE \"%cograph%\" GROUP BY graphOrder;\n" \
+					"SELECT graphOrder, count(*) FROM Graphs WHERE cograph GROUP BY graphOrder;\n" \
 					"SELECT graphOrder, graphSize, CASE WHEN graphSize <= 1.5 * graphOrder THEN \"sparse\" ELSE \"dense\" AS adjacencies FROM Graphs;\n" \
-					"SELECT count(CASE WHEN type LIKE \"%cograph%\" THEN 1 END) AS cographs,\n" \
-					"  count(CASE WHEN type LIKE \"%closed%\" THEN 1 END) AS closedGraphs\n" \
-					"  FROM Graphs;\n" \
-					"SELECT t.type, count(g.graphID) AS count\n" \
-					"  FROM (SELECT \"connected\" AS type\n" \
-					"    UNION SELECT \"cograph\"\n" \
-					"    UNION SELECT \"euler\"\n" \
-					"    UNION SELECT \"chordal\"\n" \
-					"    UNION SELECT \"claw-free\"\n" \
-					"    UNION SELECT \"closed\"\n" \
-					"  ) AS t\n" \
-					"  INNER JOIN Graphs AS g\n" \
-					"  ON g.type LIKE \"%\" || t.type || \"%\"\n" \
-					"  GROUP BY t.type ORDER BY count;\n" \
+					"SELECT sum(cograph) AS cographs, sum(closed) AS closedGraphs FROM Graphs;\n" \
+					"SELECT graphOrder, sum(connected), sum(cograph), sum(euler), sum(chordal), sum(clawfree), sum(closed), sum(cone)\n" \
+					"  FROM Graphs GROUP BY graphOrder;\n" \
+					"SELECT typeMask, count(*) AS count FROM Graphs GROUP BY typeMask ORDER BY count;\n" \
+					"SELECT count(*) AS untested FROM Graphs WHERE (testedMask & 32) == 0 AND NOT closed;\n" \
+					"\n" \
+					"Every type and value can also be evaluated directly by an SQL function (named 'is_[type]' without '-' for types and like the column for values) taking the Graph6 of a graph as a BLOB (like the column g6) or its graphOrder and graph:\n" \
+					"SELECT graphID, girth(graphOrder, COALESCE(g6, edges)) FROM Graphs WHERE is_cograph(graphOrder, COALESCE(g6, edges));\n" \
+					"SELECT graphOrder, count(*) FROM Graphs WHERE is_chordal(g6) AND cliqueNr(g6) > 3 GROUP BY graphOrder;\n" \
+					"\n" \
+					"A Graph6 file can be queried like a table without importing it, values and types are computed only for the columns a query reads:\n" \
+					"CREATE VIRTUAL TABLE temp.file USING g6file('resources/graphs.g6');\n" \
+					"SELECT rowid, edges, cliqueNr FROM file WHERE graphOrder == 7 AND chordal;\n" \
 					"\n" \
-					"UPDATE Graphs SET type = NULL, cliqueNumber = -1 WHERE graphID <> 1;\n" \
-					"DELETE FROM Graphs WHERE NOT type IS NULL;\n"
+					"UPDATE Graphs SET typeMask = 0, testedMask = 0, cliqueNr = NULL WHERE graphID <> 1;\n" \
+					"DELETE FROM Graphs WHERE typeMask <> 0;\n"
 
 
-#define import_text	"Enter 'import -[format] [file name]' to import all graphs from the file with the specified path (they are expected to be in the specified format).\n" \
+#define import_text	"Enter 'import -[format] (-compact) (-dedupe) (-batch [number]) [file name]/-cmd [command]' to import all graphs from the file with the specified path or the output of the command (they are expected to be in the specified format).\n" \
 					"\n" \
 					"--Example: import -list \"resources/graphs.txt\"\n" \
+					"--Example: import -g6 -cmd \"geng -c 11\"\n" \
 					"\n" \
 					"--Valid 'format' arguments:\n" \
 					"     -g6   : The 'Graph6' format is an efficient format for storing undirected graphs.\n" \
@@ -69,10 +75,23 @@
 					"             One graph per line, defined by graph order, followed by a space, then the list of edges.\n" \
 					"             Example : '3 {1,2},{2,3}'.\n" \
 					"\n" \
-					"--The 'file name' must specify a relative path to a correctly formatted text file. It can be entered with or without quotation marks '\"'.\n"
+					"--Every graph is stored in Graph6 format in the binary column 'g6', which is used for all computations.\n" \
+					"  The argument '-compact' is used to leave the readable column 'edges' empty, which makes the database considerably smaller.\n" \
+					"\n" \
+					"--The argument '-dedupe' is used to skip every graph isomorphic to a graph already in the database or earlier in the input, e.g., of overlapping 'geng' runs.\n" \
+					"  Isomorphic graphs are recognized by their canonical Graph6, which is stored in the indexed binary column 'canonical' (and computed for graphs imported before first).\n" \
+					"\n" \
+					"--The argument '-batch' is used to indicate a following number of graphs after which the import is committed to the database (default: all graphs at once).\n" \
+					"  Smaller batches keep completed parts of very large imports in the database if the import is interrupted, as each of them is journaled on disk.\n" \
+					"  Imports from a command or standard input are committed every 100000 graphs by default.\n" \
+					"\n" \
+					"--The 'file name' must specify a relative path to a correctly formatted text file. It can be entered with or without quotation marks '\"'.\n" \
+					"  The file name '-' stands for the standard input, which is read until its end (EOF, e.g., Ctrl+D).\n" \
+					"\n" \
+					"--The argument '-cmd' is used to indicate a following command (in quotation marks '\"'), e.g., a call of nauty's 'geng', whose output is imported while it runs.\n"
 
 
-#define compute_text	"Enter 'compute (-allexcept) (-[valueSet1] -[valueSet2] ...) (-where [condition])' to compute all specified value sets of the graphs in the database.\n" \
+#define compute_text	"Enter 'compute (-allexcept) (-[valueSet1] -[valueSet2] ...) (-threads [number]) (-where [condition])' to compute all specified value sets of the graphs in the database.\n" \
 						"\n" \
 						"--Example: compute -clique -where \"graphOrder == 4\"\n" \
 						"\n" \
@@ -85,10 +104,14 @@
 						"     -independence : Computes the independence number and the number of maximal independent (or stable) sets of each graph.\n" \
 						"     -girth        : Computes the girth of each graph, i.e., the minimum length of a cycle (or 0 if there are none).\n" \
 						"\n" \
-						"--The argument '-where' is used to indicate a following SQL query condition (in quotation marks '\"'). Only graphs satisfying this additional condition will be updated.\n"
+						"--The argument '-threads' is used to indicate a following number of worker threads sharing the computations (default: 1).\n" \
+						"\n" \
+						"--The argument '-where' is used to indicate a following SQL query condition (in quotation marks '\"'). Only graphs satisfying this additional condition will be updated.\n" \
+						"\n" \
+						"--Progress is committed every 100000 graphs or 60 seconds. If the computation is interrupted, it is kept in the internal 'Jobs' table and can be continued with 'resume'.\n"
 
 
-#define classify_text	"Enter 'classify (-allexcept) (-[type1] -[type2] ...) (-where [condition])' to classify all graphs of the specified types in the database as such.\n" \
+#define classify_text	"Enter 'classify (-allexcept) (-[type1] -[type2] ...) (-threads [number]) (-index) (-where [condition])' to classify all graphs of the specified types in the database as such.\n" \
 						"\n" \
 						"--Example: classify -allexcept -chordal -closed -where \"graphOrder < 5\"\n" \
 						"\n" \
@@ -100,15 +123,25 @@
 						"     -euler\n" \
 						"     -chordal\n" \
 						"     -claw-free\n" \
-						"     -closed      (This requires the chordal and claw-free graphs to be classified first.)\n" \
+						"     -closed\n" \
 						"     -cone\n" \
 						"\n" \
-						"--The argument '-where' is used to indicate a following SQL query condition (in quotation marks '\"'). Only graphs satisfying this additional condition will be classified.\n"
+						"--The types of a graph are stored in the column 'typeMask' with one bit per type in the order above (connected = 1, cograph = 2, euler = 4, ...).\n" \
+						"  Every type can also be queried as a boolean column named like the type without '-' (e.g., 'WHERE clawfree AND closed').\n" \
+						"  The column 'testedMask' has the bit of every type a graph has been tested for, whatever the outcome. Only graphs not yet tested for a type are tested, so classifying again only tests graphs imported since.\n" \
+						"\n" \
+						"--The argument '-threads' is used to indicate a following number of worker threads sharing the computations (default: 1).\n" \
+						"\n" \
+						"--The argument '-index' is used to create an index on the boolean column of every specified type, which speeds up queries filtering or grouping by them.\n" \
+						"\n" \
+						"--The argument '-where' is used to indicate a following SQL query condition (in quotation marks '\"'). Only graphs satisfying this additional condition will be classified.\n" \
+						"\n" \
+						"--Progress is committed every 100000 graphs or 60 seconds. If the classification is interrupted, it is kept in the internal 'Jobs' table and can be continued with 'resume'.\n"
 
 
-#define scripts_text	"Enter 'scripts [name] -[result type] (-[ordering]) (-[batch size]) ([template name]) (-where [condition])' to generate Macaulay2 scripts based on a template.\n" \
+#define scripts_text	"Enter 'scripts [name] -[result type] (-[ordering]) (-[batch size]) (-balance) (-cost [cost model]) ([template name]) (-where [condition])' to generate Macaulay2 scripts based on a template.\n" \
 						"\n" \
-						"--Example: scripts bei -closed -2500 template.m2 -where \"type LIKE '%closed%'\"\n" \
+						"--Example: scripts bei -closed -2500 template.m2 -where \"closed\"\n" \
 						"\n" \
 						"--The 'name' specifies the names of the columns which will be created for the results of the scripts as well as the file names.\n" \
 						"\n" \
@@ -121,6 +154,10 @@
 						"\n" \
 						"--The 'batch size' must be a positive integer (default is 2500). It specifies the number of graphs to be written into each script.\n" \
 						"\n" \
+						"--The argument '-balance' keeps the number of scripts, but distributes the graphs such that all scripts have about the same estimated cost instead of the same number of graphs (graphs of higher order and size take Macaulay2 much longer).\n" \
+						"\n" \
+						"--The argument '-cost' is used to indicate a following SQL expression (in quotation marks '\"') estimating the cost of a graph for '-balance' (default: \"(1 << graphOrder) * (graphSize + 1)\", multiplied by maxCliques if computed). The cost model is kept in the 'Scripts' table. Costs below 1 (or NULL) count as 1.\n" \
+						"\n" \
 						"--The 'template name' must specify a relative path to a template for a Macaulay2 script (default is \"template_[index].m2\").\n" \
 						"\n" \
 						"--The argument '-where' is used to indicate a following SQL query condition (in quotation marks '\"'). Only graphs satisfying this additional condition will be included in the scripts.\n"
@@ -130,7 +167,34 @@
 						"\n" \
 						"--Example: results -1\n" \
 						"\n" \
-						"--The 'script id' must be a valid row id from the internal 'Scripts' table of generated scripts. When omitted, the program will output the 'Scripts' table to the terminal and ask for a valid 'script id'.\n"
+						"--The 'script id' must be a valid row id from the internal 'Scripts' table of generated scripts. When omitted, the program will output the 'Scripts' table to the terminal and ask for a valid 'script id'.\n" \
+						"\n" \
+						"--Every result is added to the graph with the graphID written in front of it, so the result files may be finished in any order or on different machines. If some result files are missing, the results of the others are added and the script is kept, so that 'results' can be entered again once they are finished.\n"
+
+
+#define run_text	"Enter 'run (-[script id]) (-processes [number]) (-retries [number]) (-cmd [command])' to run the Macaulay2 scripts generated before in parallel and add their result data as soon as each of them is finished.\n" \
+					"\n" \
+					"--Example: run -1 -processes 8\n" \
+					"\n" \
+					"--The 'script id' must be a valid row id from the internal 'Scripts' table of generated scripts. When omitted, the program will output the 'Scripts' table to the terminal and ask for a valid 'script id'.\n" \
+					"\n" \
+					"--The argument '-processes' is used to indicate a following number of scripts run at the same time (default: number of cores).\n" \
+					"\n" \
+					"--The argument '-retries' is used to indicate a following number of times a script is run again if it fails or its results cannot be added (default: 1).\n" \
+					"\n" \
+					"--The argument '-cmd' is used to indicate a following command (in quotation marks '\"') running a script given as its last argument (default: \"M2 --script\").\n" \
+					"\n" \
+					"--The status, number of attempts and runtime of every script are kept in the internal 'Batches' table. Scripts already done are skipped when 'run' is entered again, and the script is removed from the 'Scripts' table once all of them are done.\n"
+
+
+#define resume_text	"Enter 'resume (-[job id])' to continue an interrupted 'compute' or 'classify' after the last graph whose results were committed.\n" \
+						"\n" \
+						"--Example: resume -1\n" \
+						"\n" \
+						"--The 'job id' must be a valid row id from the internal 'Jobs' table. When omitted, the program will output the 'Jobs' table to the terminal and ask for a valid 'job id'.\n" \
+						"\n" \
+						"--Every 'compute' and 'classify' is kept in the 'Jobs' table with its command and the graphID up to which all graphs are processed (lastGraphID) until it is complete.\n" \
+						"  Its results are committed every 100000 graphs or 60 seconds, so at most that much work is lost if the program is interrupted.\n"
 
 
 #define show_text	"Enter 'show (-[limit]) (-f) (-r)' to output the current view to the terminal.\n" \
@@ -148,29 +212,35 @@
 					"\n" \
 					"--The argument '-v' will cause the program to output LaTeX code snippets, using the TikZ package for easy visualization of all graphs in the current view.\n" \
 					"\n" \
-					"--The argument '-g6' stands for the 'Graph6' format, an efficient format for storing undirected graphs.\n"
+					"--The argument '-g6' stands for the 'Graph6' format, an efficient format for storing undirected graphs.\n" \
+					"\n" \
+					"--The arguments '-v' and '-g6' require the view to include either the column g6 or both graphOrder and edges.\n"
 
 
 // internal format lists, register new import formats here
 #define NUMBER_FORMATS 2
-typedef bool (Graph::*Read_next_format)(std::ifstream * file);
+typedef bool (Graph::*Read_next_format)(LineReader * file);
 const char * FORMATS[NUMBER_FORMATS] = { "g6", "list" };
 Read_next_format READERS[NUMBER_FORMATS] = { &Graph::read_next_g6_format, &Graph::read_next_list_format };
 
 // internal value set lists, register new value sets computed for the database here
 #define NUMBER_VALUESETS 5
 typedef std::vector<unsigned>(Graph::*Graph_values) ();
+typedef std::vector<std::vector<unsigned>>(GraphBatch::*Batch_values) ();
 const char * VALUESETS[NUMBER_VALUESETS] = { "clique", "detour", "degree", "independence", "girth" };
 std::vector<const char *> COLUMNSETS[NUMBER_VALUESETS] = { { "cliqueNr", "maxCliques" }, { "detourNr" }, { "minDeg", "maxDeg" }, { "independenceNr", "maxIndependentSets" }, { "girth" } };
 Graph_values GETTERS[NUMBER_VALUESETS] = { &Graph::get_clique_numbers, &Graph::get_detour_number, &Graph::get_extreme_degrees, &Graph::get_independence_numbers, &Graph::get_girth };
+Batch_values BATCH_GETTERS[NUMBER_VALUESETS] = { 0, 0, &GraphBatch::get_extreme_degrees, 0, 0 };
 
 // internal type lists, register new types classified in the database here
 #define NUMBER_TYPES 7
 typedef bool (Graph::*Graph_test) ();
+typedef uint64_t (GraphBatch::*Batch_test) ();
 const char * TYPES[NUMBER_TYPES] = { "connected", "cograph", "euler", "chordal", "claw-free", "closed", "cone" };
 const char * PRINT_NAMES[NUMBER_TYPES] = { "connected graphs", "cographs", "euler graphs", "chordal graphs", "claw-free graphs", "closed graphs", "cone graphs" };
 Graph_test TESTS[NUMBER_TYPES] = { &Graph::is_connected, &Graph::is_cograph, &Graph::is_euler, &Graph::is_chordal, &Graph::is_clawfree, &Graph::is_closed, &Graph::is_cone };
-const char * STD_CONDITIONS[NUMBER_TYPES] = { 0, 0, 0, 0, 0, "type LIKE '%chordal%' AND type LIKE '%claw-free%'", 0 };
+Batch_test BATCH_TESTS[NUMBER_TYPES] = { &GraphBatch::is_connected, 0, &GraphBatch::is_euler, 0, &GraphBatch::is_clawfree, 0, &GraphBatch::is_cone };
+const char * STD_CONDITIONS[NUMBER_TYPES] = { 0, 0, 0, 0, 0, 0, 0 };
 
 // internal ordering lists, register new orderings for Macaulay2 script generation here
 #define NUMBER_ORDERINGS 1
@@ -180,10 +250,13 @@ Gen_ordering GENERATORS[NUMBER_ORDERINGS] = { &Graph::gen_closed_ordering };
 
 // internal result type lists, register new result types of Macaulay2 scripts here
 #define NUMBER_RESULTS 2
-typedef bool (DatabaseInterface::*Result_inserter) (std::string * ideal, std::string * query_condition, std::string * datetime, unsigned index);
+typedef bool (DatabaseInterface::*Result_inserter) (std::string * ideal, std::string * query_condition, std::string * datetime, unsigned index, unsigned batches, int batch);
 const char * RESULTS[NUMBER_RESULTS] = { "betti", "hpoldeg" };
 Result_inserter INSERTERS[NUMBER_RESULTS] = { &DatabaseInterface::insert_betti_data, &DatabaseInterface::insert_hpoldeg_data };
 
+// command running a Macaulay2 script given as its last argument
+#define DEFAULT_M2_COMMAND "M2 --script"
+
 
 //########## helper functions ##########
 /**
@@ -251,6 +324,31 @@ int parse_unsigned(std::string * arg) {
 }
 
 
+/**
+* returns the internal list of types, the index of a type being its bit in the typeMask column
+**/
+std::vector<const char *> get_types() {
+	return std::vector<const char *>(TYPES, TYPES + NUMBER_TYPES);
+}
+
+
+/**
+* registers the SQL functions of all types and value sets and the g6file module with the database
+**/
+void register_graph_functions(DatabaseInterface * dbi) {
+	std::vector<Graph_test> tests(TESTS, TESTS + NUMBER_TYPES);
+	std::vector<const char *> types(TYPES, TYPES + NUMBER_TYPES);
+	std::vector<Graph_values> getters(GETTERS, GETTERS + NUMBER_VALUESETS);
+	std::vector<std::vector<const char *> *> columnsets;
+
+	for (int i = 0; i < NUMBER_VALUESETS; i++)
+		columnsets.push_back(&(COLUMNSETS[i]));
+
+	dbi->create_graph_functions(&tests, &types, &getters, &columnsets);
+	dbi->create_g6file_module(&tests, &types, &getters, &columnsets);
+}
+
+
 //########## parse functions ##########
 /**
 * outputs help texts to the terminal
@@ -262,6 +360,8 @@ void help_parse(DatabaseInterface * dbi, std::string * input) {
 	bool classify = false;
 	bool scripts = false;
 	bool result = false;
+	bool run = false;
+	bool resume = false;
 	bool show = false;
 	bool save = false;
 
@@ -290,6 +390,10 @@ void help_parse(DatabaseInterface * dbi, std::string * input) {
 			scripts = true;
 		else if (arg == "results")
 			result = true;
+		else if (arg == "run")
+			run = true;
+		else if (arg == "resume")
+			resume = true;
 		else if (arg == "show")
 			show = true;
 		else if (arg == "save")
@@ -316,6 +420,10 @@ void help_parse(DatabaseInterface * dbi, std::string * input) {
 			std::cout << scripts_text << std::endl;
 		else if (result)
 			std::cout << results_text << std::endl;
+		else if (run)
+			std::cout << run_text << std::endl;
+		else if (resume)
+			std::cout << resume_text << std::endl;
 		else if (show)
 			std::cout << show_text << std::endl;
 		else if (save)
@@ -332,6 +440,12 @@ void help_parse(DatabaseInterface * dbi, std::string * input) {
 **/
 void import_parse(DatabaseInterface * dbi, std::string * input) {
 	int format = -1;
+	bool compact = false;
+	bool dedupe = false;
+	bool batch_next = false;
+	int batch_size = 0;
+	bool command_next = false;
+	std::string command = "";
 	std::string filename = "";
 
 	while (!input->empty())
@@ -346,6 +460,75 @@ void import_parse(DatabaseInterface * dbi, std::string * input) {
 			return;
 		}
 
+		if (batch_next)
+		{
+			batch_size = parse_unsigned(&arg);
+			if (batch_size < 1)
+			{
+				PARSE_ERROR("The batch size must be a positive number.");
+				FAIL("Importing graphs", "");
+				return;
+			}
+			batch_next = false;
+			continue;
+		}
+
+		if (command_next)
+		{
+			command = arg;
+			command_next = false;
+			continue;
+		}
+
+		if (arg == "-cmd")
+		{
+			if (!command.empty()
+				|| !filename.empty())
+			{
+				TOO_MANY_ARG();
+				FAIL("Importing graphs", "Source already specified.");
+				return;
+			}
+			command_next = true;
+			continue;
+		}
+
+		if (arg == "-batch")
+		{
+			if (batch_size != 0)
+			{
+				TOO_MANY_ARG();
+				FAIL("Importing graphs", "Batch size already specified.");
+				return;
+			}
+			batch_next = true;
+			continue;
+		}
+
+		if (arg == "-compact")
+		{
+			if (compact)
+			{
+				TOO_MANY_ARG();
+				FAIL("Importing graphs", "'-compact' already specified.");
+				return;
+			}
+			compact = true;
+			continue;
+		}
+
+		if (arg == "-dedupe")
+		{
+			if (dedupe)
+			{
+				TOO_MANY_ARG();
+				FAIL("Importing graphs", "'-dedupe' already specified.");
+				return;
+			}
+			dedupe = true;
+			continue;
+		}
+
 		for (int i = 0; i < NUMBER_FORMATS; i++)
 		{
 			if (arg == "-" + std::string(FORMATS[i]))
@@ -362,7 +545,7 @@ void import_parse(DatabaseInterface * dbi, std::string * input) {
 			}
 		}
 
-		if (!match && filename.empty())
+		if (!match && filename.empty() && command.empty())
 		{
 			filename = arg;
 			match = true;
@@ -376,13 +559,65 @@ void import_parse(DatabaseInterface * dbi, std::string * input) {
 		}
 	}
 
+	if (batch_next)
+	{
+		FAIL("Importing graphs", "No batch size specified.");
+		return;
+	}
+
+	if (command_next)
+	{
+		FAIL("Importing graphs", "No command specified.");
+		return;
+	}
+
+	if (filename.empty()
+		&& command.empty())
+	{
+		FAIL("Importing graphs", "No file name or command specified.");
+		return;
+	}
+
 	if (format == -1)
 	{
 		FAIL("Importing graphs", "No format specified.");
 		return;
 	}
 
-	std::ifstream file(filename);
+	if (!command.empty())
+	{
+#ifdef _WIN32
+		LineReader pipe(_popen(command.c_str(), "r"), true);
+#else
+		LineReader pipe(popen(command.c_str(), "r"), true);
+#endif
+		if (!pipe.is_open())
+		{
+			FAIL("Importing graphs", "Unable to run '" << command << "'.");
+			return;
+		}
+
+		PROGRESS(3, "importing graphs from '" << command << "'");
+		int imported = dbi->import_graphs(&pipe, READERS[format], compact, batch_size == 0 ? STREAM_BATCH_SIZE : batch_size, dedupe);
+
+		int status = pipe.close();
+		if (status != 0)
+			FAIL("Importing graphs", "'" << command << "' exited with status " << status << ".");
+		else if (imported == 0)
+			FAIL("Importing graphs", "'" << command << "' produced no graphs.");
+		return;
+	}
+
+	if (filename == "-")
+	{
+		LineReader input(stdin, false);
+
+		PROGRESS(3, "importing graphs from standard input (end with EOF)");
+		dbi->import_graphs(&input, READERS[format], compact, batch_size == 0 ? STREAM_BATCH_SIZE : batch_size, dedupe);
+		return;
+	}
+
+	LineReader file(filename.c_str());
 	if (!file.is_open())
 	{
 		FAIL("Importing graphs", "Unable to open '" << filename << "'.");
@@ -390,20 +625,23 @@ void import_parse(DatabaseInterface * dbi, std::string * input) {
 	}
 
 	PROGRESS(3, "importing graphs");
-	dbi->import_graphs(&file, READERS[format]);
-	file.close();
+	dbi->import_graphs(&file, READERS[format], compact, batch_size, dedupe);
 }
 
 
 /**
 * parses the arguments for compute
 * based on that, the function calls database updates computing all specified value sets for graphs satisfying given condition
+* the computation is registered as a new job unless it resumes the job with given jobID
 **/
-void compute_parse(DatabaseInterface * dbi, std::string * input) {
+void compute_parse(DatabaseInterface * dbi, std::string * input, int jobID) {
+	std::string command = "compute " + *input;
 	bool allexcept = false;
 	std::vector<bool> to_be_computed;
 	bool condition = false;
 	std::string query_condition = "";
+	bool threads_next = false;
+	int threads = 1;
 
 	for (int i = 0; i < NUMBER_VALUESETS; i++)
 		to_be_computed.push_back(false);
@@ -428,6 +666,17 @@ void compute_parse(DatabaseInterface * dbi, std::string * input) {
 				query_condition += " AND " + arg;
 			condition = false;
 		}
+		else if (threads_next)
+		{
+			threads = parse_unsigned(&arg);
+			if (threads < 1)
+			{
+				PARSE_ERROR("The number of threads must be a positive number.");
+				FAIL("Computing values", "");
+				return;
+			}
+			threads_next = false;
+		}
 		else
 		{
 			if (arg == "-allexcept")
@@ -440,6 +689,11 @@ void compute_parse(DatabaseInterface * dbi, std::string * input) {
 				condition = true;
 				match = true;
 			}
+			else if (arg == "-threads")
+			{
+				threads_next = true;
+				match = true;
+			}
 			else
 			{
 				for (int i = 0; i < NUMBER_VALUESETS; i++)
@@ -468,26 +722,41 @@ void compute_parse(DatabaseInterface * dbi, std::string * input) {
 			to_be_computed[i] = !to_be_computed[i];
 	}
 
+	std::vector<Graph_values> getters;
+	std::vector<Batch_values> batch_getters;
+	std::vector<std::vector<const char *> *> columnsets;
+	std::string names = "";
+
 	for (int i = 0; i < NUMBER_VALUESETS; i++)
 	{
 		if (to_be_computed[i])
 		{
-			PROGRESS(1, "computing " << VALUESETS[i] << " values");
-			dbi->update_values(GETTERS[i], &(COLUMNSETS[i]), query_condition.empty() ? 0 : query_condition.c_str());
+			getters.push_back(GETTERS[i]);
+			batch_getters.push_back(BATCH_GETTERS[i]);
+			columnsets.push_back(&(COLUMNSETS[i]));
+			names += (names.empty() ? "" : ", ") + std::string(VALUESETS[i]);
 		}
 	}
+
+	PROGRESS(1, "computing " << names << " values");
+	dbi->update_values(&getters, &batch_getters, &columnsets, query_condition.empty() ? 0 : query_condition.c_str(), threads, jobID, &command);
 }
 
 
 /**
 * parses the arguments for classify
 * based on that, the function calls database updates classifying all specified types for graphs satisfying given condition
+* the classification is registered as a new job unless it resumes the job with given jobID
 **/
-void classify_parse(DatabaseInterface * dbi, std::string * input) {
+void classify_parse(DatabaseInterface * dbi, std::string * input, int jobID) {
+	std::string command = "classify " + *input;
 	bool allexcept = false;
 	std::vector<bool> to_be_classified;
 	bool condition = false;
 	std::string query_condition = "";
+	bool threads_next = false;
+	int threads = 1;
+	bool index = false;
 
 	for (int i = 0; i < NUMBER_TYPES; i++)
 		to_be_classified.push_back(false);
@@ -512,6 +781,17 @@ void classify_parse(DatabaseInterface * dbi, std::string * input) {
 				query_condition += " AND " + arg;
 			condition = false;
 		}
+		else if (threads_next)
+		{
+			threads = parse_unsigned(&arg);
+			if (threads < 1)
+			{
+				PARSE_ERROR("The number of threads must be a positive number.");
+				FAIL("Classifying graphs", "");
+				return;
+			}
+			threads_next = false;
+		}
 		else
 		{
 			if (arg == "-allexcept")
@@ -524,6 +804,16 @@ void classify_parse(DatabaseInterface * dbi, std::string * input) {
 				condition = true;
 				match = true;
 			}
+			else if (arg == "-threads")
+			{
+				threads_next = true;
+				match = true;
+			}
+			else if (arg == "-index")
+			{
+				index = true;
+				match = true;
+			}
 			else
 			{
 				for (int i = 0; i < NUMBER_TYPES; i++)
@@ -552,18 +842,118 @@ void classify_parse(DatabaseInterface * dbi, std::string * input) {
 			to_be_classified[i] = !to_be_classified[i];
 	}
 
+	std::vector<Graph_test> tests;
+	std::vector<Batch_test> batch_tests;
+	std::vector<unsigned> bits;
+	std::vector<const char *> types;
+	std::vector<const char *> conditions;
+	std::string names = "";
+
 	for (int i = 0; i < NUMBER_TYPES; i++)
 	{
 		if (to_be_classified[i])
 		{
-			PROGRESS(1, "classifying " << PRINT_NAMES[i]);
+			tests.push_back(TESTS[i]);
+			batch_tests.push_back(BATCH_TESTS[i]);
+			bits.push_back(i);
+			types.push_back(TYPES[i]);
+			conditions.push_back(STD_CONDITIONS[i]);
+			names += (names.empty() ? "" : ", ") + std::string(PRINT_NAMES[i]);
+		}
+	}
 
-			if (STD_CONDITIONS[i])
-				dbi->update_type(TESTS[i], TYPES[i], query_condition.empty() ? STD_CONDITIONS[i] : (std::string(STD_CONDITIONS[i]) + " AND " + query_condition).c_str());
-			else
-				dbi->update_type(TESTS[i], TYPES[i], query_condition.empty() ? 0 : query_condition.c_str());
+	PROGRESS(1, "classifying " << names);
+	dbi->update_types(&tests, &batch_tests, &bits, &conditions, query_condition.empty() ? 0 : query_condition.c_str(), threads, jobID, &command);
+
+	if (index)
+	{
+		PROGRESS(1, "indexing " << names);
+		dbi->create_type_indexes(&types);
+	}
+}
+
+
+/**
+* parses the arguments for resume
+* based on that, the function continues an interrupted compute or classify job after the last graph it committed
+**/
+void resume_parse(DatabaseInterface * dbi, std::string * input) {
+	int jobID = -1;
+
+	while (!input->empty())
+	{
+		std::string arg = cut_first_argument(input);
+		if (arg.empty())
+		{
+			if (input->empty())
+				break;
+			FAIL("Resuming job", "");
+			return;
+		}
+
+		if (arg.front() != '-')
+		{
+			INVALID_ARG();
+			FAIL("Resuming job", "");
+			return;
+		}
+
+		if (jobID == -1)
+		{
+			arg = arg.substr(1, std::string::npos);
+			jobID = parse_unsigned(&arg);
+			if (jobID == -1)
+			{
+				arg = "-" + arg;
+				INVALID_ARG();
+				FAIL("Resuming job", "");
+				return;
+			}
+		}
+		else
+		{
+			TOO_MANY_ARG();
+			FAIL("Resuming job", "");
+			return;
 		}
 	}
+
+	if (jobID == -1)
+	{
+		dbi->show_jobs();
+
+		while (jobID == -1)
+		{
+			INPUT("Please select a jobID to resume the respective job.");
+
+			std::string arg;
+			if (!getline(std::cin, arg))
+				return;
+
+			SEPARATE();
+
+			jobID = parse_unsigned(&arg);
+		}
+	}
+
+	std::string command;
+	int last_graphID;
+
+	if (!dbi->find_job(jobID, &command, &last_graphID))
+	{
+		FAIL("Resuming job", "There is no interrupted job with jobID " << jobID << " in the Jobs table.");
+		return;
+	}
+
+	std::string keyword = cut_first_argument(&command);
+
+	PROGRESS(1, "resuming '" << keyword << " " << command << "' after graphID " << last_graphID);
+	if (keyword == "compute")
+		compute_parse(dbi, &command, jobID);
+	else if (keyword == "classify")
+		classify_parse(dbi, &command, jobID);
+	else
+		FAIL("Resuming job", "'" << keyword << "' jobs cannot be resumed.");
 }
 
 
@@ -573,6 +963,9 @@ void classify_parse(DatabaseInterface * dbi, std::string * input) {
 **/
 void script_parse(DatabaseInterface * dbi, std::string * input) {
 	bool condition = false;
+	bool balance = false;
+	bool cost_next = false;
+	std::string cost_model = "";
 	int batch_size = -1;
 	int ordering = -1;
 	int result = -1;
@@ -600,6 +993,11 @@ void script_parse(DatabaseInterface * dbi, std::string * input) {
 				query_condition += " AND " + arg;
 			condition = false;
 		}
+		else if (cost_next)
+		{
+			cost_model = arg;
+			cost_next = false;
+		}
 		else
 		{
 			if (arg == "-where")
@@ -607,6 +1005,23 @@ void script_parse(DatabaseInterface * dbi, std::string * input) {
 				condition = true;
 				match = true;
 			}
+			else if (arg == "-balance")
+			{
+				balance = true;
+				match = true;
+			}
+			else if (arg == "-cost")
+			{
+				if (!cost_model.empty())
+				{
+					TOO_MANY_ARG();
+					FAIL("Generating M2 scripts", "Cost model already specified.");
+					return;
+				}
+				balance = true;
+				cost_next = true;
+				match = true;
+			}
 			else if (arg.front() == '-')
 			{
 				for (int i = 0; i < NUMBER_ORDERINGS; i++)
@@ -678,6 +1093,12 @@ void script_parse(DatabaseInterface * dbi, std::string * input) {
 		}
 	}
 
+	if (cost_next)
+	{
+		FAIL("Generating M2 scripts", "No cost model specified.");
+		return;
+	}
+
 	if (name.empty())
 	{
 		FAIL("Generating M2 scripts", "No ideal name specified.");
@@ -691,7 +1112,7 @@ void script_parse(DatabaseInterface * dbi, std::string * input) {
 	}
 
 	if (name.find("Bettis") == std::string::npos)
-		dbi->generate_m2_scripts(&name, ordering == -1 ? 0 : GENERATORS[ordering], batch_size == -1 ? 2500 : batch_size, query_condition.empty() ? 0 : query_condition.c_str(), filename.empty() ? 0 : filename.c_str(), ordering == -1 ? 0 : ORDERINGS[ordering], result);
+		dbi->generate_m2_scripts(&name, ordering == -1 ? 0 : GENERATORS[ordering], batch_size == -1 ? 2500 : batch_size, query_condition.empty() ? 0 : query_condition.c_str(), filename.empty() ? 0 : filename.c_str(), ordering == -1 ? 0 : ORDERINGS[ordering], result, balance ? cost_model.c_str() : 0);
 	else
 		FAIL("Generating M2 scripts", "Please choose a name other than '" << name << "'. Any name containing 'Bettis' would interfere with the program.");
 }
@@ -761,15 +1182,188 @@ void results_parse(DatabaseInterface * dbi, std::string * input) {
 	}
 
 	std::string name, query_condition, datetime;
-	int result = dbi->find_script_data(scriptID, &name, &query_condition, &datetime);
+	unsigned batches;
+	int result = dbi->find_script_data(scriptID, &name, &query_condition, &datetime, &batches);
 
 	if (result == -1)
 		return;
 
 	PROGRESS(1, "adding result data");
-	if ((dbi->*INSERTERS[result])(&name, &query_condition, &datetime, result))
+	if ((dbi->*INSERTERS[result])(&name, &query_condition, &datetime, result, batches, -1))
+	{
+		std::string statement = "DELETE FROM Scripts WHERE scriptID == " + std::to_string(scriptID) + "; DELETE FROM Batches WHERE scriptID == " + std::to_string(scriptID);
+		dbi->execute_SQL_statement(&statement);
+	}
+}
+
+
+/**
+* parses the arguments for run
+* based on that, the function runs the Macaulay2 scripts of the selected script in parallel and adds the result data of every batch as soon as it is finished
+**/
+void run_parse(DatabaseInterface * dbi, std::string * input) {
+	int scriptID = -1;
+	bool processes_next = false;
+	int processes = 0;
+	bool retries_next = false;
+	int retries = -1;
+	bool command_next = false;
+	std::string command = "";
+
+	while (!input->empty())
+	{
+		std::string arg = cut_first_argument(input);
+		if (arg.empty())
+		{
+			if (input->empty())
+				break;
+			FAIL("Running M2 scripts", "");
+			return;
+		}
+
+		if (processes_next)
+		{
+			processes = parse_unsigned(&arg);
+			if (processes < 1)
+			{
+				PARSE_ERROR("The number of processes must be a positive number.");
+				FAIL("Running M2 scripts", "");
+				return;
+			}
+			processes_next = false;
+			continue;
+		}
+
+		if (retries_next)
+		{
+			retries = parse_unsigned(&arg);
+			if (retries == -1)
+			{
+				PARSE_ERROR("The number of retries must be a number.");
+				FAIL("Running M2 scripts", "");
+				return;
+			}
+			retries_next = false;
+			continue;
+		}
+
+		if (command_next)
+		{
+			command = arg;
+			command_next = false;
+			continue;
+		}
+
+		if (arg == "-processes")
+		{
+			if (processes != 0)
+			{
+				TOO_MANY_ARG();
+				FAIL("Running M2 scripts", "Number of processes already specified.");
+				return;
+			}
+			processes_next = true;
+			continue;
+		}
+
+		if (arg == "-retries")
+		{
+			if (retries != -1)
+			{
+				TOO_MANY_ARG();
+				FAIL("Running M2 scripts", "Number of retries already specified.");
+				return;
+			}
+			retries_next = true;
+			continue;
+		}
+
+		if (arg == "-cmd")
+		{
+			if (!command.empty())
+			{
+				TOO_MANY_ARG();
+				FAIL("Running M2 scripts", "Command already specified.");
+				return;
+			}
+			command_next = true;
+			continue;
+		}
+
+		if (arg.front() != '-')
+		{
+			INVALID_ARG();
+			FAIL("Running M2 scripts", "");
+			return;
+		}
+
+		if (scriptID == -1)
+		{
+			arg = arg.substr(1, std::string::npos);
+			scriptID = parse_unsigned(&arg);
+			if (scriptID == -1)
+			{
+				arg = "-" + arg;
+				INVALID_ARG();
+				FAIL("Running M2 scripts", "");
+				return;
+			}
+		}
+		else
+		{
+			TOO_MANY_ARG();
+			FAIL("Running M2 scripts", "");
+			return;
+		}
+	}
+
+	if (processes_next
+		|| retries_next)
+	{
+		FAIL("Running M2 scripts", "No number specified.");
+		return;
+	}
+
+	if (command_next)
+	{
+		FAIL("Running M2 scripts", "No command specified.");
+		return;
+	}
+
+	if (scriptID == -1)
+	{
+		dbi->show_scripts();
+
+		while (scriptID == -1)
+		{
+			INPUT("Please select a scriptID to run the respective M2 scripts.");
+
+			std::string arg;
+			if (!getline(std::cin, arg))
+				return;
+
+			SEPARATE();
+
+			scriptID = parse_unsigned(&arg);
+		}
+	}
+
+	std::string name, query_condition, datetime;
+	unsigned batches;
+	int result = dbi->find_script_data(scriptID, &name, &query_condition, &datetime, &batches);
+
+	if (result == -1)
+		return;
+
+	if (processes == 0)
+		processes = std::thread::hardware_concurrency() == 0 ? 1 : std::thread::hardware_concurrency();
+
+	PROGRESS(1, "running M2 scripts");
+	if (dbi->run_m2_scripts(scriptID, &name, &datetime, result, batches, command.empty() ? DEFAULT_M2_COMMAND : command.c_str(), processes, retries == -1 ? 1 : retries, [dbi, &name, &query_condition, &datetime, result, batches](unsigned batch) {
+		return (dbi->*INSERTERS[result])(&name, &query_condition, &datetime, result, batches, batch);
+	}))
 	{
-		std::string statement = "DELETE FROM Scripts WHERE scriptID == " + std::to_string(scriptID);
+		std::string statement = "DELETE FROM Scripts WHERE scriptID == " + std::to_string(scriptID) + "; DELETE FROM Batches WHERE scriptID == " + std::to_string(scriptID);
 		dbi->execute_SQL_statement(&statement);
 	}
 }
@@ -963,6 +1557,12 @@ void save_parse(DatabaseInterface * dbi, std::string * input) {
 	if (filename.empty())
 		filename = "database.view";
 
+	if (!dbi->check_view())
+	{
+		FAIL("Saving view", "");
+		return;
+	}
+
 	std::ofstream file(filename, std::ios::trunc);
 
 	if (!file.is_open())
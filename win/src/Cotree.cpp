@@ -0,0 +1,114 @@
+#include "Cotree.h"
+
+
+//########## public member functions ##########
+/**
+ * appends a node of given type to the cotree and registers it as a child of parent (-1 for the root)
+ * vertex is only meaningful for leaves, i.e., the vertices of the cograph
+ * returns the index of the new node
+**/
+unsigned Cotree::add_node(unsigned type, unsigned vertex, int parent) {
+	types.push_back(type);
+	vertices.push_back(vertex);
+	children.push_back({});
+
+	unsigned index = types.size() - 1;
+	if (parent != -1)
+		children[parent].push_back(index);
+
+	return index;
+}
+
+
+/**
+ * returns the clique number and the number of inclusion-maximal cliques of the cograph
+ * children are always added after their parents, so evaluating the nodes backwards visits every child before its parent
+**/
+std::vector<unsigned> Cotree::get_clique_numbers() {
+	if (types.empty())
+		return { 0, 1 };
+
+	std::vector<unsigned> clique_numbers(types.size());
+	std::vector<unsigned> max_cliques(types.size());
+
+	for (int i = types.size() - 1; i >= 0; i--)
+	{
+		if (types[i] == LEAF_NODE)
+		{
+			clique_numbers[i] = 1;
+			max_cliques[i] = 1;
+		}
+		else if (types[i] == UNION_NODE)
+		{
+			clique_numbers[i] = 0;
+			max_cliques[i] = 0;
+
+			for (unsigned child : children[i])
+			{
+				if (clique_numbers[i] < clique_numbers[child])
+					clique_numbers[i] = clique_numbers[child];
+				max_cliques[i] += max_cliques[child];
+			}
+		}
+		else
+		{
+			clique_numbers[i] = 0;
+			max_cliques[i] = 1;
+
+			for (unsigned child : children[i])
+			{
+				clique_numbers[i] += clique_numbers[child];
+				max_cliques[i] *= max_cliques[child];
+			}
+		}
+	}
+
+	return { clique_numbers[0], max_cliques[0] };
+}
+
+
+/**
+ * returns the independence number and the number of inclusion-maximal independent sets of the cograph
+ * these are the clique numbers of the complement, whose cotree only swaps union and join nodes
+**/
+std::vector<unsigned> Cotree::get_independence_numbers() {
+	if (types.empty())
+		return { 0, 1 };
+
+	std::vector<unsigned> independence_numbers(types.size());
+	std::vector<unsigned> max_independent_sets(types.size());
+
+	for (int i = types.size() - 1; i >= 0; i--)
+	{
+		if (types[i] == LEAF_NODE)
+		{
+			independence_numbers[i] = 1;
+			max_independent_sets[i] = 1;
+		}
+		else if (types[i] == JOIN_NODE)
+		{
+			independence_numbers[i] = 0;
+			max_independent_sets[i] = 0;
+
+			for (unsigned child : children[i])
+			{
+				if (independence_numbers[i] < independence_numbers[child])
+					independence_numbers[i] = independence_numbers[child];
+				max_independent_sets[i] += max_independent_sets[child];
+			}
+		}
+		else
+		{
+			independence_numbers[i] = 0;
+			max_independent_sets[i] = 1;
+
+			for (unsigned child : children[i])
+			{
+				independence_numbers[i] += independence_numbers[child];
+				max_independent_sets[i] *= max_independent_sets[child];
+			}
+		}
+	}
+
+	return { independence_numbers[0], max_independent_sets[0] };
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "stdafx.h"
+
+
+#define LEAF_NODE	0
+#define UNION_NODE	1
+#define JOIN_NODE	2
+
+
+class Cotree
+{
+public:
+	std::vector<unsigned> types;
+	std::vector<unsigned> vertices;
+	std::vector<std::vector<unsigned>> children;
+
+	Cotree() : types{}, vertices{}, children{} {}
+
+
+	unsigned add_node(unsigned type, unsigned vertex, int parent);
+
+	std::vector<unsigned> get_clique_numbers();
+	std::vector<unsigned> get_independence_numbers();
+};
@@ -4,8 +4,94 @@
 #include "sqlite3.h"
 
 #include "Graph.h"
+#include "GraphBatch.h"
 #include "BettiTable.h"
 
+#include <functional>
+#include <memory>
+
+
+#define PIPELINE_CHUNK_SIZE 64
+#define VIEW_CACHE_SIZE 1000
+#define IMPORT_CACHE_SIZE "-65536"
+#define STREAM_BATCH_SIZE 100000
+#define NULL_VALUE 0xFFFFFFFF
+#define CHECKPOINT_GRAPHS 100000
+#define CHECKPOINT_SECONDS 60
+#define DEFAULT_COST_MODEL "(1 << graphOrder) * (graphSize + 1)"
+
+
+/**
+* row of the graphs table handed from the reader to the workers of the compute and classify pipeline
+**/
+struct Graph_row
+{
+	int graphID;
+	unsigned order;
+	std::string edges;	// Graph6 bytes if g6 is set, list of edges otherwise
+	bool g6;
+	uint64_t flags;
+};
+
+
+/**
+* result of a job on a graph handed from the workers to the writer of the compute and classify pipeline
+* values equal to NULL_VALUE are written as NULL, nothing is written for a graph that could not be decoded (invalid)
+**/
+struct Graph_result
+{
+	int graphID;
+	bool update;
+	bool invalid;
+	std::vector<unsigned> values;
+};
+
+
+/**
+* job evaluated on every chunk of rows of the pipeline, changes the results (one per row, in the same order) to the values to be written and whether they are to be written
+* working on whole chunks lets jobs evaluate graphs of the same order together in a GraphBatch
+**/
+typedef std::function<void(std::vector<Graph_row> * rows, std::vector<Graph_result> * results)> Graph_job;
+
+
+/**
+* event handed from the workers running Macaulay2 scripts to the thread adding their results
+* a batch is reported once when its script is started and once when it has finished (successfully if it returned 0 and wrote its result file)
+**/
+struct Batch_event
+{
+	unsigned batch;
+	bool started;
+	bool success;
+	double runtime;
+};
+
+
+/**
+* last graph decoded by the SQL graph functions, shared by all of them, so that several functions on the same row decode it only once
+* values holds the results of the value getters on that graph (computed at most once per graph and getter)
+**/
+struct Function_cache
+{
+	std::string key;	// graphOrder and graph bytes of the decoded graph
+	Graph graph;
+	std::vector<std::vector<unsigned>> values;
+	std::vector<bool> computed;
+};
+
+
+/**
+* SQL graph function registered by create_graph_functions, either a type test or the value with given index of the value getter with given number
+**/
+struct Graph_function
+{
+	std::shared_ptr<Function_cache> cache;
+	bool (Graph::*test)();
+	std::vector<unsigned>(Graph::*getter)();
+	unsigned getter_number;
+	unsigned value_index;
+};
+
 
 class DatabaseInterface
 {
@@ -13,17 +99,32 @@ private:
 	sqlite3 * database;
 
 	unsigned number_columns;
-	unsigned number_rows;
 
+	std::string view_query;
 	std::vector<std::string> view_columns;
-	std::vector<std::vector<std::string>> view_contents;
+	std::vector<std::vector<std::string>> view_cache;
+	bool view_complete;
+	int view_changes;			// total changes of the connection when the view was created
+	std::string view_data_version;	// data version of the database file when the view was created (changes with commits of other connections)
+
+	std::string get_pragma(const char * pragma);
+	std::string get_default_cost_model();
+	std::string resume_condition(int jobID);
+
+	std::vector<std::string> read_view_row(sqlite3_stmt * stmt);
+	bool step_view(std::function<bool(unsigned index, std::vector<std::string> * row)> visit);
+	std::vector<unsigned> get_column_widths(int limit);
 
-	std::vector<unsigned> column_widths;
+	Graph_row read_row(sqlite3_stmt * qry);
+	bool write_result(sqlite3_stmt * stmt, Graph_result * result, unsigned number_values);
+	void print_table(const char * query);
+
+	unsigned process_graphs(sqlite3_stmt * qry, sqlite3_stmt * stmt, Graph_job job, unsigned number_values, unsigned threads, const char * progress, int jobID = -1);
 
 public:
 	DatabaseInterface() {}
 
-	DatabaseInterface(const char * database_file_name) : number_columns(0), number_rows(0), view_columns{}, view_contents{}, column_widths{} {
+	DatabaseInterface(const char * database_file_name) : number_columns(0), view_query(""), view_columns{}, view_cache{}, view_complete(true), view_changes(0), view_data_version("") {
 		if (sqlite3_open(database_file_name, &database))
 		{
 			std::cout << "Unable to open database: " << sqlite3_errmsg(database) << std::endl;
@@ -44,6 +145,7 @@ public:
 	}
 
 	void reset_view();
+	bool check_view(int limit = -1);
 
 	void show_view(int limit = 100);
 	void save_view(std::ofstream * file);
@@ -54,22 +156,33 @@ public:
 	void save_view_visualisation(std::ofstream * file);
 	void save_view_g6(std::ofstream * file);
 
-	void generate_m2_scripts(std::string * idealname, unsigned * (Graph::*gen_ordering)(), unsigned batch_size, const char * query_condition, const char * filename, const char * ordering_name, unsigned index);
+	void generate_m2_scripts(std::string * idealname, unsigned * (Graph::*gen_ordering)(), unsigned batch_size, const char * query_condition, const char * filename, const char * ordering_name, unsigned index, const char * cost_model = 0);
 
 	void show_scripts();
+	void show_jobs();
 
 	bool execute_SQL_query(std::string * query);
 	bool execute_SQL_statement(std::string * statement);
 
 	bool create_scripts_table();
-	bool create_graphs_table();
+	bool create_jobs_table();
+	bool create_graphs_table(std::vector<const char *> * types);
+	void create_type_indexes(std::vector<const char *> * types);
+	bool create_graph_functions(std::vector<bool (Graph::*)()> * graph_tests, std::vector<const char *> * types, std::vector<std::vector<unsigned>(Graph::*)()> * graph_values, std::vector<std::vector<const char *> *> * columns);
+	bool create_g6file_module(std::vector<bool (Graph::*)()> * graph_tests, std::vector<const char *> * types, std::vector<std::vector<unsigned>(Graph::*)()> * graph_values, std::vector<std::vector<const char *> *> * columns);
+
+	int import_graphs(LineReader * file, bool (Graph::*Read_next_format)(LineReader * file), bool compact = false, unsigned batch_size = 0, bool dedupe = false);
+	bool update_canonical_forms();
+
+	bool update_types(std::vector<bool (Graph::*)()> * graph_tests, std::vector<uint64_t (GraphBatch::*)()> * batch_tests, std::vector<unsigned> * type_bits, std::vector<const char *> * type_conditions, const char * query_condition, unsigned threads = 1, int jobID = -1, std::string * command = 0);
+	bool update_values(std::vector<std::vector<unsigned>(Graph::*)()> * graph_values, std::vector<std::vector<std::vector<unsigned>>(GraphBatch::*)()> * batch_values, std::vector<std::vector<const char *> *> * columns, const char * query_condition, unsigned threads = 1, int jobID = -1, std::string * command = 0);
 
-	void import_graphs(std::ifstream * file, bool (Graph::*Read_next_format)(std::ifstream * file));
+	int create_job(std::string * command);
+	bool find_job(int jobID, std::string * command, int * last_graphID);
 
-	bool update_type(bool (Graph::*graph_test)(), const char * type, const char * query_condition);
-	bool update_values(std::vector<unsigned>(Graph::*graph_values)(), std::vector<const char *> * columns, const char * query_condition);
+	unsigned find_script_data(unsigned scriptID, std::string * ideal, std::string * query_condition, std::string * datetime, unsigned * batches);
+	bool insert_betti_data(std::string * ideal, std::string * query_condition, std::string * datetime, unsigned index, unsigned batches, int batch = -1);
+	bool insert_hpoldeg_data(std::string * ideal, std::string * query_condition, std::string * datetime, unsigned index, unsigned batches, int batch = -1);
 
-	unsigned find_script_data(unsigned scriptID, std::string * ideal, std::string * query_condition, std::string * datetime);
-	bool insert_betti_data(std::string * ideal, std::string * query_condition, std::string * datetime, unsigned index);
-	bool insert_hpoldeg_data(std::string * ideal, std::string * query_condition, std::string * datetime, unsigned index);
+	bool run_m2_scripts(unsigned scriptID, std::string * ideal, std::string * datetime, unsigned index, unsigned batches, const char * command, unsigned processes, unsigned retries, std::function<bool(unsigned batch)> insert_batch);
 };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "stdafx.h"
+#include "sqlite3.h"
+
+#include "Graph.h"
+#include "LineReader.h"
+
+
+/**
+* types and value sets offered as columns by every table of the g6file module
+* the columns of a table are graphOrder, graphSize, edges, g6, the value columns and the type columns (in this order)
+**/
+struct G6_file_module
+{
+	std::vector<std::vector<unsigned>(Graph::*)()> getters;
+	std::vector<std::vector<std::string>> value_columns;
+	std::vector<bool (Graph::*)()> tests;
+	std::vector<std::string> type_columns;
+};
+
+
+/**
+* virtual table over the graphs of a Graph6 file, created by 'CREATE VIRTUAL TABLE [name] USING g6file([file name])'
+**/
+struct G6_file_table : sqlite3_vtab
+{
+	std::string filename;
+	G6_file_module * module;
+};
+
+
+/**
+* position of a scan of a g6file table, the rowid of a graph is its number within the file (starting with 1)
+* only graphs with minimum_order <= graphOrder <= maximum_order are visited, they are decoded and their values computed only if a column needs them
+**/
+struct G6_file_cursor : sqlite3_vtab_cursor
+{
+	LineReader * file;
+	sqlite3_int64 rowid;
+	const char * line;
+	unsigned length;
+	bool eof;
+
+	unsigned minimum_order;
+	unsigned maximum_order;
+
+	Graph graph;
+	bool decoded;
+	bool valid;
+	std::vector<std::vector<unsigned>> values;
+	std::vector<bool> computed;
+};
+
+
+int create_g6file_module(sqlite3 * database, G6_file_module * module);
@@ -1,33 +1,95 @@
 #pragma once
 
 #include "stdafx.h"
+#include "Cotree.h"
+#include "LineReader.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+/**
+* counts the set bits of a vertex mask
+**/
+inline unsigned count_set_bits(uint64_t mask) {
+#ifdef _MSC_VER
+	return (unsigned)__popcnt64(mask);
+#else
+	return (unsigned)__builtin_popcountll(mask);
+#endif
+}
+
+
+/**
+* returns the index of the lowest set bit of a non-empty vertex mask
+**/
+inline unsigned lowest_set_bit(uint64_t mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return (unsigned)index;
+#else
+	return (unsigned)__builtin_ctzll(mask);
+#endif
+}
+
+
+/**
+* returns the index of the highest set bit of a non-empty vertex mask
+**/
+inline unsigned highest_set_bit(uint64_t mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, mask);
+	return (unsigned)index;
+#else
+	return 63 - (unsigned)__builtin_clzll(mask);
+#endif
+}
+
+
+/**
+* state of the search for the canonical labeling of a graph: its first and best leaf so far and the automorphisms found on the way
+* a leaf is given by the path of individualized vertices, its labeling (labeling[i] is the vertex index getting label i) and the adjacency rows of the relabelled graph
+**/
+struct Canonical_search
+{
+	std::vector<unsigned> first_path;
+	std::vector<unsigned> first_labeling;
+	std::vector<uint64_t> first_rows;
+
+	std::vector<unsigned> best_path;
+	std::vector<unsigned> best_labeling;
+	std::vector<uint64_t> best_rows;
+
+	std::vector<std::vector<unsigned>> automorphisms;	// automorphisms[k][i] is the image of vertex index i
+};
 
 
 class Graph
 {
 private:
 	unsigned order;
-	unsigned * adjacencies;
+	uint64_t * adjacencies;		// one row per vertex, bit w-1 of row v-1 is set iff v and w are adjacent
 	unsigned size;
 
-	unsigned bron_kerbosch_pivot(std::vector<std::vector<unsigned>> * max_cliques, unsigned clique_number, std::vector<unsigned> * include_all, std::vector<unsigned> * include_some, std::vector<unsigned> * include_none);
+	void bron_kerbosch_pivot(const uint64_t * rows, unsigned clique_size, uint64_t include_some, uint64_t include_none, unsigned * clique_number, unsigned * max_cliques);
 
-	bool is_induced_connected(unsigned * vertices, unsigned subset_order);
-	bool is_induced_path(int subset, unsigned subset_order);
-	bool is_induced_claw(int subset);
+	uint64_t get_reachable(unsigned vertex, uint64_t allowed, bool complement = false);
+	void extend_induced_path(unsigned last, unsigned length, uint64_t blocked, unsigned bound, unsigned * max_detour);
 
-	bool is_universal(unsigned vertex);
-	bool is_simplicial(unsigned vertex, bool * visited);
+	bool is_induced_connected(uint64_t subset);
+	bool build_cotree(Cotree * cotree, uint64_t subset, int parent);
 
-	std::pair<unsigned, unsigned> get_simplicial_pair(bool * visited);
+	bool is_universal(unsigned vertex);
 
 	std::pair<unsigned *, unsigned *> gen_lexicographic_ordering();
+	void gen_lexicographic_ordering_plus(unsigned * previous_indices, unsigned * ordering, unsigned * ordering_indices);
+	bool gen_proper_interval_ordering(unsigned * ordering);
 
-	bool peo_swappable(unsigned * peo, unsigned * h, int t);
-	bool peo_move(unsigned * peo, unsigned * peo_indices, unsigned * h, int t);
-	bool peo_switch(unsigned * peo, unsigned * peo_indices, unsigned * h, unsigned * a, unsigned * b, int t);
-	bool test_pe_orderings(unsigned * peo, unsigned * peo_indices, unsigned * h, unsigned * a, unsigned * b, unsigned i);
-	void gen_initial_peo(unsigned * peo, unsigned * peo_indices, unsigned * h, unsigned * a, unsigned * b);
+	void refine_partition(std::vector<uint64_t> * cells);
+	unsigned search_canonical_labeling(std::vector<uint64_t> * cells, std::vector<unsigned> * path, Canonical_search * search);
 
 public:
 	Graph() : order(0), size(0) {
@@ -38,24 +100,26 @@ public:
 		if (order > 62)
 			throw "tooManyVertices";
 
-		adjacencies = new unsigned[order * order];
+		adjacencies = new uint64_t[order];
 
-		for (unsigned i = 0; i < order * order; i++)
+		for (unsigned i = 0; i < order; i++)
 			adjacencies[i] = 0;
 	}
 
-	Graph(unsigned order, unsigned * adj);
+	Graph(unsigned order, uint64_t * adj);
 
 	Graph(const Graph &g) {
 		order = g.order;
 		size = g.size;
-		adjacencies = new unsigned[order*order];
-		for (unsigned i = 0; i < order * order; i++)
+		adjacencies = new uint64_t[order];
+		for (unsigned i = 0; i < order; i++)
 			adjacencies[i] = g.adjacencies[i];
 	}
 
-	void read_graph_from_line(unsigned order, std::string * edges);
-	void read_graph_from_vector(unsigned order, std::vector<std::pair<unsigned, unsigned>> * edges);
+	bool read_graph_from_line(unsigned order, std::string * edges);
+	bool read_graph_from_vector(unsigned order, std::vector<std::pair<unsigned, unsigned>> * edges);
+	bool read_graph_from_g6(const char * g6, unsigned length);
+	bool read_graph_from_g6(std::string * g6);
 
 	Graph(unsigned order, std::string * edges) {
 		adjacencies = 0;
@@ -68,6 +132,7 @@ public:
 	}
 
 	Graph& operator=(Graph && graph) {
+		delete[] adjacencies;
 		order = graph.order;
 		graph.order = 0;
 		adjacencies = graph.adjacencies;
@@ -89,11 +154,13 @@ public:
 	std::string convert_to_string();
 	std::string convert_to_string_wrt_ordering(unsigned * ordering);
 	std::string convert_to_g6_format();
+	std::string convert_to_canonical_g6_format();
 
 	bool adjacent(unsigned v, unsigned w);
+	uint64_t get_neighbours(unsigned vertex);
 
-	bool read_next_g6_format(std::ifstream * file);
-	bool read_next_list_format(std::ifstream * file);
+	bool read_next_g6_format(LineReader * file);
+	bool read_next_list_format(LineReader * file);
 
 	Graph get_complement();
 
@@ -103,6 +170,8 @@ public:
 	std::vector<unsigned> get_independence_numbers();
 	std::vector<unsigned> get_girth();
 
+	bool gen_cotree(Cotree * cotree);
+
 	bool is_closed_wrt_labeling(unsigned * peo, unsigned * peo_indices);
 
 	bool is_connected();
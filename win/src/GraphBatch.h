@@ -0,0 +1,56 @@
+#pragma once
+
+#include "stdafx.h"
+#include "Graph.h"
+
+
+#define BATCH_SIZE 64
+#define BATCH_MAX_ORDER 16
+#define BATCH_MIN_GRAPHS 8
+#define DEGREE_BITS 6
+
+
+/**
+* up to 64 graphs of the same order stored as transposed bit planes, so that cheap invariants are evaluated for all of them at once with word-wide operations
+* bit k of the plane of two vertices is set iff they are adjacent in the k-th graph added to the batch
+* tests return a mask with bit k set iff the k-th graph passes, values are returned per graph just like the respective member functions of Graph
+* the work per batch grows quickly with the order, so batches are only worth it for small orders (up to BATCH_MAX_ORDER)
+**/
+class GraphBatch
+{
+private:
+	unsigned order;
+	unsigned count;
+	std::vector<uint64_t> planes;	// planes[v * order + w] for vertex indices v and w
+	std::vector<std::pair<unsigned, unsigned>> g6_positions;	// vertex indices of the bits of the upper triangle in Graph6 order
+
+	uint64_t & plane(unsigned v, unsigned w) {
+		return planes[v * order + w];
+	}
+
+	uint64_t get_used();
+	void count_degree(unsigned v, uint64_t * degree);
+
+public:
+	GraphBatch(unsigned order) : order(order), count(0), planes(order * order, 0) {
+		for (unsigned w = 1; w < order; w++)
+		{
+			for (unsigned v = 0; v < w; v++)
+				g6_positions.push_back(std::make_pair(v, w));
+		}
+	}
+
+
+	unsigned get_order();
+	unsigned get_count();
+
+	bool add_graph(Graph * g);
+	bool add_graph_from_g6(const char * g6, unsigned length);
+
+	std::vector<std::vector<unsigned>> get_extreme_degrees();
+
+	uint64_t is_connected();
+	uint64_t is_euler();
+	uint64_t is_clawfree();
+	uint64_t is_cone();
+};
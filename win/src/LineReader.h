@@ -0,0 +1,52 @@
+#pragma once
+
+#include "stdafx.h"
+
+#include <cstdio>
+
+
+#define STREAM_BUFFER_SIZE 65536
+
+
+/**
+* read-only source of the lines of an import file or stream
+* a file is memory-mapped, so lines can be handed out as pointers into the mapping without copying them
+* a stream (e.g., stdin or the pipe of a child process) is read in blocks into a buffer, lines are handed out as pointers into the buffer
+**/
+class LineReader
+{
+private:
+	const char * data;
+	size_t length;
+	size_t position;
+	bool open;
+
+	FILE * stream;
+	bool process;
+	std::vector<char> buffer;
+
+	bool fill_buffer();
+
+#ifdef _WIN32
+	void * file_handle;
+	void * mapping_handle;
+#else
+	int descriptor;
+#endif
+
+public:
+	LineReader(const char * filename);
+	LineReader(FILE * stream, bool process);
+
+	LineReader(const LineReader &) = delete;
+	LineReader& operator=(const LineReader &) = delete;
+
+	~LineReader();
+
+
+	bool is_open();
+	int close();
+
+	bool read_line(const char ** line, unsigned * line_length);
+	bool read_line(std::string * line);
+};
@@ -40,6 +40,10 @@ int io_interface(DatabaseInterface * dbi) {
 		classify_parse(dbi, &input);
 	else if (keyword == "results")
 		results_parse(dbi, &input);
+	else if (keyword == "run")
+		run_parse(dbi, &input);
+	else if (keyword == "resume")
+		resume_parse(dbi, &input);
 	else if (keyword == "scripts")
 		script_parse(dbi, &input);
 	else if (keyword == "compute")
@@ -57,7 +61,7 @@ int io_interface(DatabaseInterface * dbi) {
 //########## main function ##########
 /**
  * opens the given database (if none is specified it opens 'Graphs.db'),
- * creates scripts and graphs table, if they do not exist
+ * creates scripts, graphs and jobs table, if they do not exist
  * prints help text and calls io_interface
 **/
 int main(int argc, char * argv[]) {
@@ -73,8 +77,12 @@ int main(int argc, char * argv[]) {
 	else
 		dbi = DatabaseInterface("Graphs.db");
 
+	std::vector<const char *> types = get_types();
+
 	dbi.create_scripts_table();
-	dbi.create_graphs_table();
+	dbi.create_graphs_table(&types);
+	dbi.create_jobs_table();
+	register_graph_functions(&dbi);
 
 	std::string temp = "";
 	help_parse(&dbi, &temp);
@@ -6,12 +6,16 @@
 
 std::string cut_first_argument(std::string * input);
 int parse_unsigned(std::string * arg);
+std::vector<const char *> get_types();
+void register_graph_functions(DatabaseInterface * dbi);
 
 void help_parse		(DatabaseInterface * dbi, std::string * input);
 void import_parse	(DatabaseInterface * dbi, std::string * input);
-void compute_parse	(DatabaseInterface * dbi, std::string * input);
-void classify_parse	(DatabaseInterface * dbi, std::string * input);
+void compute_parse	(DatabaseInterface * dbi, std::string * input, int jobID = -1);
+void classify_parse	(DatabaseInterface * dbi, std::string * input, int jobID = -1);
 void script_parse	(DatabaseInterface * dbi, std::string * input);
 void results_parse	(DatabaseInterface * dbi, std::string * input);
+void run_parse		(DatabaseInterface * dbi, std::string * input);
+void resume_parse	(DatabaseInterface * dbi, std::string * input);
 void show_parse		(DatabaseInterface * dbi, std::string * input);
 void save_parse		(DatabaseInterface * dbi, std::string * input);
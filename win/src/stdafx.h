@@ -4,6 +4,7 @@
 #include <fstream>
 #include <vector>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 #define PARSE_ERROR(X)	((std::cout << "Parse error: " << X << std::endl),																				(void)0)